@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2024 Igor Zinken https://www.igorski.nl
+ * Copyright (c) 2024-2026 Igor Zinken https://www.igorski.nl
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -17,35 +17,65 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
-#include "ParameterSubscriber.h"
 
-class ParameterListener : public juce::ValueTree::Listener
+/**
+ * Collects the changes of all automatable parameters as a bitmask of parameter indices (in order of the
+ * parameter layout). Parameters can change on any thread (host automation usually arrives on the audio thread,
+ * the editor changes them on the message thread), the listener only flags the changed parameter. The audio
+ * thread drains the mask once per block, so any amount of changes in between collapses into a single update.
+ */
+class ParameterListener : private juce::AudioProcessorParameter::Listener
 {
     public:
-        ParameterListener( ParameterSubscriber& subscriber, juce::AudioProcessorValueTreeState& vts ) : subscriberRef( subscriber ), valueTreeState( vts )
+        using Mask = juce::uint64;
+        static constexpr int MAX_PARAMETERS = 64; // the amount of flags within a Mask
+
+        explicit ParameterListener( juce::AudioProcessorValueTreeState& vts ) : valueTreeState( vts )
         {
-            valueTreeState.state.addListener( this );
+            for ( auto* parameter : valueTreeState.processor.getParameters()) {
+                jassert( parameter->getParameterIndex() < MAX_PARAMETERS );
+                parameter->addListener( this );
+            }
         }
 
         ~ParameterListener() override
         {
-            valueTreeState.state.removeListener( this );
+            for ( auto* parameter : valueTreeState.processor.getParameters()) {
+                parameter->removeListener( this );
+            }
         }
 
-        void valueTreePropertyChanged( juce::ValueTree& tree, const juce::Identifier& property ) override
+        // the flags of provided parameters within the masks returned by drain()
+        Mask getFlags( std::initializer_list<juce::String> ids ) const
         {
-            juce::ignoreUnused( tree, property );
-            subscriberRef.updateParameters();
+            Mask flags = 0;
+            for ( const auto& id : ids ) {
+                if ( auto* parameter = valueTreeState.getParameter( id )) {
+                    flags |= Mask( 1 ) << parameter->getParameterIndex();
+                }
+            }
+            return flags;
         }
 
-        /*
-        void valueTreeChildAdded       ( juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded ) override {}
-        void valueTreeChildRemoved     ( juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenRemoved, int ) override {}
-        void valueTreeChildOrderChanged( juce::ValueTree& parentTree, int, int ) override {}
-        void valueTreeParentChanged    ( juce::ValueTree& treeWhoseParentHasChanged ) override {}
-        */
+        // returns the flags of all parameters that changed since the last call and clears them. The
+        // mask has a single consumer : the audio thread (or the thread preparing the processor)
+        Mask drain()
+        {
+            return dirty.exchange( 0, std::memory_order_acquire );
+        }
 
     private:
-        ParameterSubscriber& subscriberRef;
         juce::AudioProcessorValueTreeState& valueTreeState;
+        std::atomic<Mask> dirty { 0 };
+
+        void parameterValueChanged( int parameterIndex, float newValue ) override
+        {
+            juce::ignoreUnused( newValue );
+            dirty.fetch_or( Mask( 1 ) << parameterIndex, std::memory_order_release );
+        }
+
+        void parameterGestureChanged( int parameterIndex, bool gestureIsStarting ) override
+        {
+            juce::ignoreUnused( parameterIndex, gestureIsStarting );
+        }
 };
@@ -23,6 +23,24 @@ namespace Parameters {
     static juce::String LINK_ENABLED  = "linkEnabled";
     static juce::String SPLIT_FREQ    = "splitFreq";
     static juce::String SPLIT_MODE    = "splitMode";
+    static juce::String ANTI_ALIASING = "antiAliasing";
+    static juce::String FFT_SIZE      = "fftSize";
+    static juce::String FFT_OVERLAP   = "fftOverlap";
+    static juce::String OVERSAMPLING  = "oversampling";
+    static juce::String BAND_COUNT    = "bandCount";
+
+    // the splits between the bands of the EQ split (where SPLIT_FREQ is the lowest split), only
+    // the first BAND_COUNT - 1 splits are used
+
+    static juce::String SPLIT_FREQ_2 = "splitFreq2";
+    static juce::String SPLIT_FREQ_3 = "splitFreq3";
+    static juce::String SPLIT_FREQ_4 = "splitFreq4";
+
+    // harmonic split properties
+
+    static juce::String HARMONIC_COUNT   = "harmonicCount";
+    static juce::String HARMONIC_WIDTH   = "harmonicWidth";
+    static juce::String HARMONIC_FALLOFF = "harmonicFalloff";
     
     // low distortion properties
 
@@ -38,22 +56,129 @@ namespace Parameters {
     static juce::String HI_DIST_DRIVE = "hiDrive";
     static juce::String HI_DIST_PARAM = "hiParam";
 
+    // mid distortion properties (mirrored from low), for the bands in between the low and high band
+
+    static juce::String MID1_DIST_TYPE  = "mid1Type";
+    static juce::String MID1_DIST_INPUT = "mid1Input";
+    static juce::String MID1_DIST_DRIVE = "mid1Drive";
+    static juce::String MID1_DIST_PARAM = "mid1Param";
+
+    static juce::String MID2_DIST_TYPE  = "mid2Type";
+    static juce::String MID2_DIST_INPUT = "mid2Input";
+    static juce::String MID2_DIST_DRIVE = "mid2Drive";
+    static juce::String MID2_DIST_PARAM = "mid2Param";
+
+    static juce::String MID3_DIST_TYPE  = "mid3Type";
+    static juce::String MID3_DIST_INPUT = "mid3Input";
+    static juce::String MID3_DIST_DRIVE = "mid3Drive";
+    static juce::String MID3_DIST_PARAM = "mid3Param";
+
+    // modulation sources : two tempo-synced LFOs and an envelope follower (tracking the input level)
+
+    static juce::String LFO1_RATE  = "lfo1Rate";
+    static juce::String LFO1_SHAPE = "lfo1Shape";
+    static juce::String LFO2_RATE  = "lfo2Rate";
+    static juce::String LFO2_SHAPE = "lfo2Shape";
+
+    static juce::String ENV_ATTACK  = "envAttack";
+    static juce::String ENV_RELEASE = "envRelease";
+
+    // modulation routes, each connecting a source to a target (see ParameterUtilities::getModulationTargetNames())
+
+    static juce::String MOD1_SOURCE = "mod1Source";
+    static juce::String MOD1_TARGET = "mod1Target";
+    static juce::String MOD1_DEPTH  = "mod1Depth";
+
+    static juce::String MOD2_SOURCE = "mod2Source";
+    static juce::String MOD2_TARGET = "mod2Target";
+    static juce::String MOD2_DEPTH  = "mod2Depth";
+
+    static juce::String MOD3_SOURCE = "mod3Source";
+    static juce::String MOD3_TARGET = "mod3Target";
+    static juce::String MOD3_DEPTH  = "mod3Depth";
+
+    static juce::String MOD4_SOURCE = "mod4Source";
+    static juce::String MOD4_TARGET = "mod4Target";
+    static juce::String MOD4_DEPTH  = "mod4Depth";
+
+    // the properties of each band, in order : low, mid 1 - 3 and high. The EQ split uses the low properties for its
+    // first band, the high properties for its last band and the mid properties (in order) for the bands in between
+
+    struct BandProperties {
+        juce::String type;
+        juce::String input;
+        juce::String drive;
+        juce::String param;
+    };
+
+    static const BandProperties BANDS[] = {
+        { LO_DIST_TYPE,   LO_DIST_INPUT,   LO_DIST_DRIVE,   LO_DIST_PARAM },
+        { MID1_DIST_TYPE, MID1_DIST_INPUT, MID1_DIST_DRIVE, MID1_DIST_PARAM },
+        { MID2_DIST_TYPE, MID2_DIST_INPUT, MID2_DIST_DRIVE, MID2_DIST_PARAM },
+        { MID3_DIST_TYPE, MID3_DIST_INPUT, MID3_DIST_DRIVE, MID3_DIST_PARAM },
+        { HI_DIST_TYPE,   HI_DIST_INPUT,   HI_DIST_DRIVE,   HI_DIST_PARAM }
+    };
+    static const int MAX_BANDS = 5;
+
+    static const juce::String SPLITS[] = { SPLIT_FREQ, SPLIT_FREQ_2, SPLIT_FREQ_3, SPLIT_FREQ_4 };
+
+    struct LFOProperties {
+        juce::String rate;
+        juce::String shape;
+    };
+
+    static const LFOProperties LFOS[] = {
+        { LFO1_RATE, LFO1_SHAPE },
+        { LFO2_RATE, LFO2_SHAPE }
+    };
+
+    struct RouteProperties {
+        juce::String source;
+        juce::String target;
+        juce::String depth;
+    };
+
+    static const RouteProperties ROUTES[] = {
+        { MOD1_SOURCE, MOD1_TARGET, MOD1_DEPTH },
+        { MOD2_SOURCE, MOD2_TARGET, MOD2_DEPTH },
+        { MOD3_SOURCE, MOD3_TARGET, MOD3_DEPTH },
+        { MOD4_SOURCE, MOD4_TARGET, MOD4_DEPTH }
+    };
+    static const int NUM_LFOS   = 2;
+    static const int NUM_ROUTES = 4;
+
     namespace Ranges {
         static float SPLIT_FREQ_MIN = 20.f;
         static float SPLIT_FREQ_MAX = 5000.f;
+        static float UPPER_SPLIT_FREQ_MAX = 16000.f; // for the splits above the first
+
+        static int BAND_COUNT_MIN = 2;
+        static int BAND_COUNT_MAX = Parameters::MAX_BANDS;
+
+        static int   HARMONIC_COUNT_MIN   = 1;     // specifies how many harmonics of base freq are considered related
+        static int   HARMONIC_COUNT_MAX   = 16;
+        static float HARMONIC_WIDTH_MIN   = 0.01f; // how close a frequency needs to match a harmonic to be considered
+        static float HARMONIC_WIDTH_MAX   = 1.f;   // related (relative to the frequency of the harmonic)
+        static float HARMONIC_FALLOFF_MIN = 0.f;   // 0 = equal weights, 1 = natural harmonic spread, 2 = emphasis on lower harmonics
+        static float HARMONIC_FALLOFF_MAX = 2.f;
 
-        static float HARMONIC_COUNT   = 10.f; // specifies how many harmonics of base freq are considered related (1 - 16)
-        static float HARMONIC_WIDTH   = 0.3f; // how close a frequency needs to match a harmonic to be considered related ( 0.5 - 10 )
-        static float HARMONIC_FALLOFF = 1.0f; // 0 = pure fundamental, 1 = natural harmonic spread, 2 = high harmonic emphasis
+        static float ENV_TIME_MIN = 0.001f; // in seconds
+        static float ENV_TIME_MAX = 2.f;
+
+        static float SPLIT_MODULATION_OCTAVES = 2.f; // the range (up and down) of the split frequencies at full depth
     }
 
     namespace FFT {
-        static const int ORDER = 11; // 2048-point FFT
+        static const int MIN_ORDER     = 9;  // 512-point FFT
+        static const int MAX_ORDER     = 13; // 8192-point FFT
+        static const int DEFAULT_ORDER = 11; // 2048-point FFT, at the reference sample rate
+
+        // the automatic FFT order scales with the sample rate relative to this rate (keeping the bin spacing roughly constant)
+        static const double REFERENCE_SAMPLE_RATE = 48000.0;
 
-        // these are deduced from above ORDER
-        static const unsigned long SIZE        = 1 << Parameters::FFT::ORDER;
-        static const unsigned long HOP_SIZE    = Parameters::FFT::SIZE / 2;
-        static const unsigned long DOUBLE_SIZE = Parameters::FFT::SIZE * 2;
+        // these are deduced from above MAX_ORDER (buffers are allocated to fit the largest FFT)
+        static const unsigned long MAX_SIZE        = 1 << Parameters::FFT::MAX_ORDER;
+        static const unsigned long MAX_DOUBLE_SIZE = Parameters::FFT::MAX_SIZE * 2;
     }
 
     enum class SplitMode {
@@ -74,7 +199,28 @@ namespace Parameters {
         static int DIST_TYPE_DEF_HI = static_cast<int>( DistortionType::WaveFolder );
         static float DIST_INPUT_DEF = 1.f;
         static float SPLIT_FREQ_DEF = 440.f;
+        static float SPLIT_FREQ_2_DEF = 1500.f;
+        static float SPLIT_FREQ_3_DEF = 4000.f;
+        static float SPLIT_FREQ_4_DEF = 8000.f;
+        static int   BAND_COUNT_DEF = 2;
+        static int DIST_TYPE_DEF_MID = static_cast<int>( DistortionType::Off );
         static float DIST_DRIVE_DEF = 0.5f;
         static float DIST_PARAM_DEF = 0.70f;
+        static int ANTI_ALIASING_DEF = 0; // see AntiAliasing::Order
+        static int FFT_SIZE_DEF    = 0; // automatic, see ParameterUtilities::getFFTSizeNames()
+        static int FFT_OVERLAP_DEF = 0; // 2x, see ParameterUtilities::getFFTOverlapNames()
+        static int OVERSAMPLING_DEF = 0; // off, see ParameterUtilities::getOversamplingNames()
+        static int   HARMONIC_COUNT_DEF   = 10;
+        static float HARMONIC_WIDTH_DEF   = 0.3f;
+        static float HARMONIC_FALLOFF_DEF = 1.0f;
+        static int   LFO_RATE_DEF    = 2; // 1 bar, see ParameterUtilities::getLFORateNames()
+        static float ENV_ATTACK_DEF  = 0.01f;
+        static float ENV_RELEASE_DEF = 0.2f;
+
+        // whether the memoryless distortion modules read their curve from a precomputed transfer table
+        static bool USE_TRANSFER_TABLES = true;
+
+        // whether channels can be processed in parallel on worker threads (see AudioPluginAudioProcessor::setParallelProcessing())
+        static bool PARALLEL_PROCESSING = false;
     }
 }
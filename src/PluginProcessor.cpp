@@ -26,9 +26,10 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor(): AudioProcessor( BusesPro
         .withOutput( "Output", juce::AudioChannelSet::stereo(), true )
     #endif
     ),
-    ParameterSubscriber(),
     parameters( *this, nullptr, "PARAMETERS", createParameterLayout()),
-    parameterListener( *this, parameters ) 
+    parameterListener( parameters ),
+    presets( parameters ),
+    randomSeed(( juce::uint32 ) juce::Random::getSystemRandom().nextInt()) // differs per instance unless specified
 {
     // grab a reference to all automatable parameters and initialize the values (to their defined defaults)
 
@@ -36,24 +37,74 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor(): AudioProcessor( BusesPro
     splitFreq        = parameters.getRawParameterValue( Parameters::SPLIT_FREQ );
     splitMode        = static_cast<Parameters::SplitMode>( parameters.getRawParameterValue( Parameters::SPLIT_MODE )->load());
     dryWetMix        = parameters.getRawParameterValue( Parameters::DRY_WET_MIX );
-    loDistType       = static_cast<Parameters::DistortionType>( parameters.getRawParameterValue( Parameters::LO_DIST_TYPE )->load());
-    loDistInputLevel = parameters.getRawParameterValue( Parameters::LO_DIST_INPUT );
-    loDistDrive      = parameters.getRawParameterValue( Parameters::LO_DIST_DRIVE );
-    loDistParam      = parameters.getRawParameterValue( Parameters::LO_DIST_PARAM );
-    hiDistType       = static_cast<Parameters::DistortionType>( parameters.getRawParameterValue( Parameters::HI_DIST_TYPE )->load());
-    hiDistInputLevel = parameters.getRawParameterValue( Parameters::HI_DIST_INPUT );
-    hiDistDrive      = parameters.getRawParameterValue( Parameters::HI_DIST_DRIVE );
-    hiDistParam      = parameters.getRawParameterValue( Parameters::HI_DIST_PARAM );
+    antiAliasing     = parameters.getRawParameterValue( Parameters::ANTI_ALIASING );
+    fftSize          = parameters.getRawParameterValue( Parameters::FFT_SIZE );
+    fftOverlap       = parameters.getRawParameterValue( Parameters::FFT_OVERLAP );
+    oversampling     = parameters.getRawParameterValue( Parameters::OVERSAMPLING );
+    harmonicCount    = parameters.getRawParameterValue( Parameters::HARMONIC_COUNT );
+    harmonicWidth    = parameters.getRawParameterValue( Parameters::HARMONIC_WIDTH );
+    harmonicFalloff  = parameters.getRawParameterValue( Parameters::HARMONIC_FALLOFF );
+    bandCount        = parameters.getRawParameterValue( Parameters::BAND_COUNT );
+    splitModeValue   = parameters.getRawParameterValue( Parameters::SPLIT_MODE );
+
+    for ( size_t split = 0; split < splitFreqs.size(); ++split ) {
+        splitFreqs[ split ] = parameters.getRawParameterValue( Parameters::SPLITS[ split ]);
+    }
+
+    for ( size_t lfo = 0; lfo < lfoRates.size(); ++lfo ) {
+        lfoRates[ lfo ]  = parameters.getRawParameterValue( Parameters::LFOS[ lfo ].rate );
+        lfoShapes[ lfo ] = parameters.getRawParameterValue( Parameters::LFOS[ lfo ].shape );
+    }
+    envAttack  = parameters.getRawParameterValue( Parameters::ENV_ATTACK );
+    envRelease = parameters.getRawParameterValue( Parameters::ENV_RELEASE );
+
+    for ( size_t route = 0; route < modulationRoutes.size(); ++route ) {
+        const auto& properties = Parameters::ROUTES[ route ];
+
+        modulationRoutes[ route ] = {
+            parameters.getRawParameterValue( properties.source ),
+            parameters.getRawParameterValue( properties.target ),
+            parameters.getRawParameterValue( properties.depth )
+        };
+    }
+
+    for ( size_t slot = 0; slot < bands.size(); ++slot ) {
+        const auto& properties = Parameters::BANDS[ slot ];
+        auto& band = bands[ slot ];
+
+        band.typeValue  = parameters.getRawParameterValue( properties.type );
+        band.inputLevel = parameters.getRawParameterValue( properties.input );
+        band.drive      = parameters.getRawParameterValue( properties.drive );
+        band.param      = parameters.getRawParameterValue( properties.param );
+        band.type       = static_cast<Parameters::DistortionType>( band.typeValue->load());
+    }
+
+    // the parameters that require an update when changed (the others are read directly during processing)
+
+    latencyFlags      = parameterListener.getFlags({ Parameters::SPLIT_MODE, Parameters::FFT_SIZE, Parameters::OVERSAMPLING });
+    bandCountFlags    = parameterListener.getFlags({ Parameters::BAND_COUNT });
+    antiAliasingFlags = parameterListener.getFlags({ Parameters::ANTI_ALIASING });
+    distTypeFlags     = parameterListener.getFlags({ Parameters::LINK_ENABLED });
+    smoothedFlags     = parameterListener.getFlags({ Parameters::SPLITS[ 0 ], Parameters::SPLITS[ 1 ], Parameters::SPLITS[ 2 ], Parameters::SPLITS[ 3 ] });
 
-    // prepare resources for FFT processing
+    for ( const auto& properties : Parameters::BANDS ) {
+        distTypeFlags |= parameterListener.getFlags({ properties.type });
+        smoothedFlags |= parameterListener.getFlags({ properties.input, properties.drive, properties.param });
+    }
+
+    modulationFlags = parameterListener.getFlags({ Parameters::ENV_ATTACK, Parameters::ENV_RELEASE });
 
-    specA.resize(( size_t ) Parameters::FFT::DOUBLE_SIZE, 0.f );
-    specB.resize(( size_t ) Parameters::FFT::DOUBLE_SIZE, 0.f );
+    for ( const auto& properties : Parameters::LFOS ) {
+        modulationFlags |= parameterListener.getFlags({ properties.rate, properties.shape });
+    }
+    for ( const auto& properties : Parameters::ROUTES ) {
+        modulationFlags |= parameterListener.getFlags({ properties.source, properties.target, properties.depth });
+    }
 }
 
 AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
 {
-    // nowt...
+    cancelPendingUpdate();
 }
 
 /* configuration */
@@ -69,8 +120,11 @@ bool AudioPluginAudioProcessor::isBusesLayoutSupported( const BusesLayout& layou
     juce::ignoreUnused( layouts );
     return true;
   #else
-    if ( layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono() &&
-         layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo()) {
+    // any layout is supported (channels are processed independently) up to MAX_CHANNELS
+
+    const auto& outputChannelSet = layouts.getMainOutputChannelSet();
+
+    if ( outputChannelSet.isDisabled() || outputChannelSet.size() > MAX_CHANNELS ) {
         return false;
     }
 
@@ -113,161 +167,296 @@ bool AudioPluginAudioProcessor::isMidiEffect() const
 
 double AudioPluginAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    const double sampleRate = getSampleRate();
+
+    if ( sampleRate <= 0.0 ) {
+        return DECAY_TIME_SECONDS;
+    }
+    return static_cast<double>( getTailSamples( sampleRate )) / sampleRate;
 }
 
 /* programs */
 
 int AudioPluginAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    loadUserPrograms();
+    return presets.getNumPresets(); // at least the factory presets
 }
 
 int AudioPluginAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getSelected();
 }
 
 void AudioPluginAudioProcessor::setCurrentProgram( int index )
 {
-    juce::ignoreUnused( index );
+    // can be invoked on any thread, the program is applied at the start of the next block (see processBlock())
+    presets.select( index );
 }
 
 const juce::String AudioPluginAudioProcessor::getProgramName( int index )
 {
-    juce::ignoreUnused( index );
-    return {};
+    loadUserPrograms();
+    return presets.getName( index );
 }
 
 void AudioPluginAudioProcessor::changeProgramName( int index, const juce::String& newName )
 {
-    juce::ignoreUnused( index, newName );
+    loadUserPrograms();
+
+    if ( presets.setName( index, newName )) {
+        presets.saveUserPresets( PresetBank::getUserPresetFile());
+        updateHostDisplay( ChangeDetails().withProgramChanged( true ));
+    }
+}
+
+int AudioPluginAudioProcessor::saveProgram( const juce::String& name )
+{
+    loadUserPrograms();
+
+    const int index = presets.addUserPreset( name );
+
+    if ( index >= 0 ) {
+        presets.saveUserPresets( PresetBank::getUserPresetFile());
+        presets.setSelected( index ); // the parameters already hold its values
+        updateHostDisplay( ChangeDetails().withProgramChanged( true ));
+    }
+    return index;
+}
+
+void AudioPluginAudioProcessor::loadUserPrograms()
+{
+    // the user presets are read on first use of the programs rather than on construction, so instances that never list
+    // the programs (e.g. those of the offline renderer and the benchmark) don't perform disk I/O nor depend on the user
+    // presets. As the bank is only modified on the message thread, the presets are not loaded on any other thread
+
+    if ( userProgramsLoaded || !juce::MessageManager::existsAndIsCurrentThread()) {
+        return;
+    }
+    userProgramsLoaded = true;
+    presets.loadUserPresets( PresetBank::getUserPresetFile());
 }
 
 /* automatable parameters */
 
-void AudioPluginAudioProcessor::updateParameters()
+bool AudioPluginAudioProcessor::updateParameters( ParameterListener::Mask changed )
 {
-    bool forceApply = false;
+    bool distTypeChanged = false;
 
-    splitMode = static_cast<Parameters::SplitMode>(
-        parameters.getRawParameterValue( Parameters::SPLIT_MODE )->load()
-    );
-    auto newLoDistType = static_cast<Parameters::DistortionType>(
-        parameters.getRawParameterValue( Parameters::LO_DIST_TYPE )->load()
-    );
-    auto newHiDistType = static_cast<Parameters::DistortionType>(
-        parameters.getRawParameterValue( Parameters::HI_DIST_TYPE )->load()
-    );
+    // the harmonic split and the oversampling delay the signal, report this to the host for delay compensation. As this
+    // notifies the host (which is not realtime safe) the latency is reported on the message thread (see handleAsyncUpdate())
 
-    if ( newLoDistType != loDistType || newHiDistType != hiDistType ) {
-        loDistType = newLoDistType;
-        hiDistType = newHiDistType;
+    if (( changed & latencyFlags ) != 0 ) {
+        splitMode = static_cast<Parameters::SplitMode>( splitModeValue->load());
 
-        forceApply = true;
+        const int latency = getLatencyForMode( splitMode );
+        if ( latencySamples.exchange( latency ) != latency ) {
+            triggerAsyncUpdate();
+        }
+    }
+
+    if (( changed & bandCountFlags ) != 0 ) {
+        const int newNumBands = juce::jlimit( Parameters::Ranges::BAND_COUNT_MIN, Parameters::Ranges::BAND_COUNT_MAX, static_cast<int>( bandCount->load()));
+
+        // the bands are oversampled in pairs, which differ when the amount of bands changes
+
+        if ( newNumBands != numBands ) {
+            numBands = newNumBands;
+
+            for ( auto& context : channelContexts ) {
+                for ( auto& oversampler : context.oversamplers ) {
+                    oversampler.reset();
+                }
+            }
+        }
+        crossover.setNumBands( numBands );
     }
-    splitFreqSmoothed.set( *splitFreq );
-    loLevelSmoothed.set( *loDistInputLevel );
-    loDriveSmoothed.set( *loDistDrive );
-    loParamSmoothed.set( *loDistParam );
-    hiLevelSmoothed.set( *hiDistInputLevel );
-    hiDriveSmoothed.set( *hiDistDrive );
-    hiParamSmoothed.set( *hiDistParam );
 
-    applyParameters( 0, forceApply );
+    if (( changed & antiAliasingFlags ) != 0 ) {
+        const auto antiAliasingOrder = static_cast<AntiAliasing::Order>( antiAliasing->load());
+
+        for ( auto& band : bands ) {
+            band.fuzz.setAntiAliasing( antiAliasingOrder );
+            band.waveFolder.setAntiAliasing( antiAliasingOrder );
+        }
+    }
+
+    if (( changed & distTypeFlags ) != 0 ) {
+        // (un)linking the bands changes the settings of all slots other than the low slot
+
+        const bool newLinkBands = ParameterUtilities::floatToBool( *linkEnabled );
+
+        if ( newLinkBands != linkBands ) {
+            linkBands = newLinkBands;
+            distTypeChanged = true;
+        }
+
+        for ( size_t slot = 0; slot < bands.size(); ++slot ) {
+            const auto newDistType = static_cast<Parameters::DistortionType>( bands[ ( size_t ) getSource(( int ) slot )].typeValue->load());
+
+            if ( newDistType != bands[ slot ].type ) {
+                bands[ slot ].type = newDistType;
+                distTypeChanged = true;
+            }
+        }
+    }
+
+    if (( changed & smoothedFlags ) != 0 ) {
+        for ( size_t split = 0; split < splitFreqs.size(); ++split ) {
+            smoothers.set( SplitFreq + ( int ) split, *splitFreqs[ split ]);
+        }
+        for ( size_t slot = 0; slot < bands.size(); ++slot ) {
+            const int level = getLevelIndex(( int ) slot );
+
+            smoothers.set( level,     *bands[ slot ].inputLevel );
+            smoothers.set( level + 1, *bands[ slot ].drive );
+            smoothers.set( level + 2, *bands[ slot ].param );
+        }
+    }
+
+    // a change of routes can leave targets unmodulated, these are restored by updating all slots
+
+    if (( changed & modulationFlags ) != 0 ) {
+        updateModulation();
+        distTypeChanged = true;
+    }
+    return distTypeChanged;
 }
 
-void AudioPluginAudioProcessor::applyParameters( int samplesToAdvance, bool force )
+void AudioPluginAudioProcessor::handleAsyncUpdate()
 {
-    if ( !splitFreqSmoothed.isDone() ) {
-        const float baseFreq = splitFreqSmoothed.peek( samplesToAdvance );
+    const int latency = latencySamples.load();
 
-        for ( int channel = 0; channel < MAX_CHANNELS; ++channel ) {
-            loPass[ channel ].setCutoffFrequency( baseFreq );
-            hiPass[ channel ].setCutoffFrequency( baseFreq );
-        }
+    if ( latency != getLatencySamples()) {
+        setLatencySamples( latency );
+    }
+}
+
+void AudioPluginAudioProcessor::applyParameters( bool force )
+{
+    // the modules are provided with the values at the end of the last processed block. While interpolating or modulated, the
+    // distortion of the EQ split reads the per-sample values from the ramps instead (see getRamps()), the crossover follows per block
+
+    const bool isSplitModulated = modulation.isModulated( ModulationMatrix::SplitFrequency );
+
+    const float splitOctaves = isSplitModulated ? modulation.getValue( ModulationMatrix::SplitFrequency ) * Parameters::Ranges::SPLIT_MODULATION_OCTAVES : 0.f;
+
+    splitModulation = std::exp2( splitOctaves );
+
+    if ( force || isSplitModulated || smoothers.isSmoothing( SplitFreq, BandLevel - 1 )) {
+        updateCrossover();
     }
-    bool updateLoDistortion = force || !loLevelSmoothed.isDone() || !loDriveSmoothed.isDone() || !loParamSmoothed.isDone();
-    bool updateHiDistortion = force || !hiLevelSmoothed.isDone() || !hiDriveSmoothed.isDone() || !hiParamSmoothed.isDone();
 
-    if ( updateLoDistortion )
+    for ( size_t slot = 0; slot < bands.size(); ++slot )
     {
-        const float loLevel = loLevelSmoothed.peek( samplesToAdvance );
-        const float loDrive = loDriveSmoothed.peek( samplesToAdvance );
-        const float loParam = loParamSmoothed.peek( samplesToAdvance );
+        const int source = getSource(( int ) slot );
+        const int level  = getLevelIndex( source );
+
+        if ( !force && !isModulated( source ) && !smoothers.isSmoothing( level, level + 2 )) {
+            continue;
+        }
+        auto& band = bands[ slot ];
+
+        const float bandLevel = smoothers.get( level );
+        const float bandDrive = getModulatedValue( level + 1, ModulationMatrix::getDriveTarget( source ));
+        const float bandParam = getModulatedValue( level + 2, ModulationMatrix::getParamTarget( source ));
 
-        switch ( loDistType )
+        switch ( band.type )
         {
             case Parameters::DistortionType::Off:
                 break;
 
             case Parameters::DistortionType::BitCrusher:
-                for ( size_t channel = 0; channel < MAX_CHANNELS; ++channel ) {
-                    loBitCrusher[ channel ].setLevel( loLevel );
-                    loBitCrusher[ channel ].setDownsampling( loDrive );
-                    loBitCrusher[ channel ].setAmount( loParam );
+                for ( auto& context : channelContexts ) {
+                    auto& bitCrusher = context.bitCrushers[ slot ];
+                    bitCrusher.setLevel( bandLevel );
+                    bitCrusher.setDownsampling( bandDrive );
+                    bitCrusher.setAmount( bandParam );
                 }
                 break;
 
             case Parameters::DistortionType::Fuzz:
-                loFuzz.setInputLevel( loLevel );
-                loFuzz.setThreshold( loDrive );
-                loFuzz.setCutOff( loParam );
+                band.fuzz.setInputLevel( bandLevel );
+                band.fuzz.setThreshold( bandDrive );
+                band.fuzz.setCutOff( bandParam );
                 break;
 
             case Parameters::DistortionType::WaveFolder:
-                loWaveFolder.setLevel( loLevel );
-                loWaveFolder.setDrive( loDrive );
-                loWaveFolder.setThreshold( loParam );
-                // loWaveFolder.setThresholdNegative( loParam );
+                band.waveFolder.setLevel( bandLevel );
+                band.waveFolder.setDrive( bandDrive );
+                band.waveFolder.setThreshold( bandParam );
+                // band.waveFolder.setThresholdNegative( bandParam );
                 break;
 
             case Parameters::DistortionType::WaveShaper:
-                loWaveShaper.setOutputLevel( loLevel );
-                loWaveShaper.setAmount( loDrive );
-                loWaveShaper.setShape( loParam );
+                band.waveShaper.setOutputLevel( bandLevel );
+                band.waveShaper.setAmount( bandDrive );
+                band.waveShaper.setShape( bandParam );
                 break;
         }
     }
+}
 
-    if ( updateHiDistortion )
-    {
-        const float hiLevel = hiLevelSmoothed.peek( samplesToAdvance );
-        const float hiDrive = hiDriveSmoothed.peek( samplesToAdvance );
-        const float hiParam = hiParamSmoothed.peek( samplesToAdvance );
+void AudioPluginAudioProcessor::updateCrossover()
+{
+    // the splits of the crossover tree must be ascending, a split below the split preceding it is moved up onto it.
+    // While only some of the splits move (or none, e.g. while their modulation is at a standstill) the others are left as is
 
-        switch ( hiDistType )
-        {
-            case Parameters::DistortionType::Off:
-                break;
-                
-            case Parameters::DistortionType::BitCrusher:
-                for ( size_t channel = 0; channel < MAX_CHANNELS; ++channel ) {
-                    hiBitCrusher[ channel ].setLevel( hiLevel );
-                    hiBitCrusher[ channel ].setDownsampling( hiDrive );
-                    hiBitCrusher[ channel ].setAmount( hiParam );
-                }
-                break;
+    float frequency = 0.f;
 
-            case Parameters::DistortionType::Fuzz:
-                hiFuzz.setInputLevel( hiLevel );
-                hiFuzz.setThreshold( hiDrive );
-                hiFuzz.setCutOff( hiParam );
-                break;
+    for ( int split = 0; split < MAX_BANDS - 1; ++split ) {
+        frequency = juce::jmax( frequency, getSplitFrequency( split ));
 
-            case Parameters::DistortionType::WaveFolder:
-                hiWaveFolder.setLevel( hiLevel );
-                hiWaveFolder.setDrive( hiDrive );
-                hiWaveFolder.setThreshold( hiParam );
-                // hiWaveFolder.setThresholdNegative( hiParam );
-                break;
+        auto& appliedFrequency = crossoverFrequencies[ ( size_t ) split ];
 
-            case Parameters::DistortionType::WaveShaper:
-                hiWaveShaper.setOutputLevel( hiLevel );
-                hiWaveShaper.setAmount( hiDrive );
-                hiWaveShaper.setShape( hiParam );
-                break;
+        if ( frequency != appliedFrequency ) {
+            appliedFrequency = frequency;
+            crossover.setCutoffFrequency( split, frequency );
+        }
+    }
+}
+
+void AudioPluginAudioProcessor::updateModulation()
+{
+    for ( size_t lfo = 0; lfo < lfoRates.size(); ++lfo ) {
+        modulation.setLFO(
+            ( int ) lfo,
+            ModulationMatrix::getBeatsPerCycle( static_cast<int>( lfoRates[ lfo ]->load()), timeSigNumerator, timeSigDenominator ),
+            static_cast<ModulationMatrix::Shape>( static_cast<int>( lfoShapes[ lfo ]->load()))
+        );
+    }
+    modulation.setEnvelope( envAttack->load(), envRelease->load());
+
+    for ( size_t route = 0; route < modulationRoutes.size(); ++route ) {
+        const auto& properties = modulationRoutes[ route ];
+
+        modulation.setRoute(
+            ( int ) route,
+            static_cast<ModulationMatrix::Source>( static_cast<int>( properties.source->load())),
+            static_cast<int>( properties.target->load()),
+            properties.depth->load()
+        );
+    }
+}
+
+void AudioPluginAudioProcessor::renderModulation()
+{
+    // the modulated drive and param of each slot (offsetting the values of their smoothers), where slots that are
+    // linked to another slot use the values of that slot (see getRamps())
+
+    for ( int slot = 0; slot < MAX_BANDS; ++slot ) {
+        if ( getSource( slot ) != slot ) {
+            continue;
+        }
+        const int level       = getLevelIndex( slot );
+        const int driveTarget = ModulationMatrix::getDriveTarget( slot );
+        const int paramTarget = ModulationMatrix::getParamTarget( slot );
+
+        if ( modulation.isModulated( driveTarget )) {
+            modulation.render( driveTarget, smoothers.getRamp( level + 1 ), getModulationRamp( driveTarget ), 1.f, 0.f, 1.f );
+        }
+        if ( modulation.isModulated( paramTarget )) {
+            modulation.render( paramTarget, smoothers.getRamp( level + 2 ), getModulationRamp( paramTarget ), 1.f, 0.f, 1.f );
         }
     }
 }
@@ -279,51 +468,146 @@ void AudioPluginAudioProcessor::prepareToPlay( double sampleRate, int samplesPer
     // dispose previously allocated resources
     releaseResources();
 
-    fft.update( sampleRate );
+    preparedBlockSize = samplesPerBlock; // all buffers below are sized to this, larger blocks are split (see processBlock())
 
-    splitFreqSmoothed.init( sampleRate, PARAM_RAMP_TIME_SECONDS, *splitFreq );
-    loLevelSmoothed.init( sampleRate, PARAM_RAMP_TIME_SECONDS, *loDistInputLevel );
-    loDriveSmoothed.init( sampleRate, PARAM_RAMP_TIME_SECONDS, *loDistDrive );
-    loParamSmoothed.init( sampleRate, PARAM_RAMP_TIME_SECONDS, *loDistParam );
-    hiLevelSmoothed.init( sampleRate, PARAM_RAMP_TIME_SECONDS, *hiDistInputLevel );
-    hiDriveSmoothed.init( sampleRate, PARAM_RAMP_TIME_SECONDS, *hiDistDrive );
-    hiParamSmoothed.init( sampleRate, PARAM_RAMP_TIME_SECONDS, *hiDistParam );
+    // when parallel processing is enabled, a worker pool is created to share the channels of the bus layout
+    // with, where each lane (the audio thread and each worker) has its own scratch buffers and FFT workspace
 
-    juce::dsp::ProcessSpec spec {
-        sampleRate,
-        ( juce::uint32 ) samplesPerBlock,
-        ( juce::uint32 ) 1 // one filter per channel
-    };
+    const size_t numChannels = ( size_t ) juce::jlimit( 1, MAX_CHANNELS, juce::jmax( getTotalNumInputChannels(), getTotalNumOutputChannels()));
+    const int numWorkers = parallelProcessing ? juce::jmin( MAX_WORKERS, ( int ) numChannels - 1, juce::SystemStats::getNumCpus() - 1 ) : 0;
 
-    for ( size_t channel = 0; channel < MAX_CHANNELS; ++channel )
-    {
-        loMakeup[ channel ].prepare( sampleRate );
-        hiMakeup[ channel ].prepare( sampleRate );
+    if ( numWorkers <= 0 ) {
+        workerPool.reset();
+    } else if ( workerPool == nullptr || workerPool->getNumLanes() != numWorkers + 1 ) {
+        workerPool = std::make_unique<WorkerPool>( numWorkers );
+    }
+    const size_t numLanes = workerPool != nullptr ? ( size_t ) workerPool->getNumLanes() : 1;
+
+    const int tileSize = juce::jmin( TILE_SIZE, samplesPerBlock );
+
+    lanes.resize( numLanes );
+    for ( auto& lane : lanes ) {
+        lane.spareBand.resize(( size_t ) tileSize );
+        lane.inBuffer.resize(( size_t ) samplesPerBlock );
+        lane.specA.resize(( size_t ) Parameters::FFT::MAX_DOUBLE_SIZE, 0.f );
+        lane.specB.resize(( size_t ) Parameters::FFT::MAX_DOUBLE_SIZE, 0.f );
+        lane.oversampled.prepare( tileSize );
+    }
+    useWorkerPool     = false; // until the work load has been measured
+    averageWorkMicros = 0.0;
+
+    fft.prepare( sampleRate, ( int ) numLanes );
+    fft.configure( getFFTOrder(), getFFTOverlap());
+
+    smoothers.prepare( NumSmoothedParameters, sampleRate, PARAM_RAMP_TIME_SECONDS, samplesPerBlock );
+    for ( size_t split = 0; split < splitFreqs.size(); ++split ) {
+        smoothers.setCurrentAndTarget( SplitFreq + ( int ) split, *splitFreqs[ split ]);
+    }
+    for ( size_t slot = 0; slot < bands.size(); ++slot ) {
+        const int level = getLevelIndex(( int ) slot );
+
+        smoothers.setCurrentAndTarget( level,     *bands[ slot ].inputLevel );
+        smoothers.setCurrentAndTarget( level + 1, *bands[ slot ].drive );
+        smoothers.setCurrentAndTarget( level + 2, *bands[ slot ].param );
+    }
 
-        dcFilters[ channel ].init( sampleRate );
-        
-        loPass[ channel ].prepare( spec );
-        hiPass[ channel ].prepare( spec );
+    modulation.prepare( sampleRate, samplesPerBlock );
+    modulationRampSize = ( size_t ) samplesPerBlock;
+    modulationPool.assign( modulationRampSize * ( ModulationMatrix::NumTargets - 1 ), 0.f );
+    splitModulation = 1.f;
 
-        prepareCrossoverFilter( loPass[ channel ], juce::dsp::LinkwitzRileyFilterType::lowpass,  splitFreqSmoothed.get() );
-        prepareCrossoverFilter( hiPass[ channel ], juce::dsp::LinkwitzRileyFilterType::highpass, splitFreqSmoothed.get() );
+    crossover.prepare( sampleRate, ( int ) numChannels, samplesPerBlock );
+    crossoverFrequencies.fill( -1.f );
+    updateCrossover();
+    dcFilter.prepare( sampleRate, ( int ) numChannels, samplesPerBlock );
+    analysisTap.prepare( sampleRate );
 
-        auto& channelState = channelStates[ channel ];
-        if ( !channelState.initialised ) {
-            channelState.inputBuffer.assign ( Parameters::FFT::SIZE, 0.0f );
-            channelState.outputBuffer.assign( Parameters::FFT::SIZE, 0.0f );
-            channelState.initialised = true;
+    // allocate the per-channel state for the current bus layout (as a single pool, along with the FFT rings and the bands)
+
+    const size_t ringSize    = ( size_t ) Parameters::FFT::MAX_SIZE;
+    const size_t bandSize    = ( size_t ) samplesPerBlock;
+
+    if ( channelContexts.size() != numChannels ) {
+        channelContexts = std::vector<ChannelContext>( numChannels );
+        ringPool.assign( numChannels * ringSize * 2, 0.f );
+    }
+    bandPool.assign( numChannels * bandSize * MAX_BANDS, 0.f );
+
+    for ( size_t channel = 0; channel < numChannels; ++channel )
+    {
+        auto& context = channelContexts[ channel ];
+
+        for ( size_t slot = 0; slot < ( size_t ) MAX_BANDS; ++slot ) {
+            context.bitCrushers[ slot ].prepare( samplesPerBlock );
+            context.bitCrushers[ slot ].setSeed( randomSeed + ( juce::uint32 ) ( slot * MAX_CHANNELS + channel ));
+            context.antiAliasing[ slot ].reset();
+            context.makeup[ slot ].prepare( sampleRate, samplesPerBlock );
+
+            context.bands[ slot ] = bandPool.data() + ( channel * MAX_BANDS + slot ) * bandSize;
+        }
+        for ( auto& oversampler : context.oversamplers ) {
+            oversampler.reset();
         }
+
+        context.fftState.inputRing  = ringPool.data() + channel * ringSize * 2;
+        context.fftState.outputRing = context.fftState.inputRing + ringSize;
+        context.fftState.reset();
+
+        context.silentSamples = 0;
+        context.idle = false;
     }
-    loBuffer.resize(( size_t ) samplesPerBlock );
-    hiBuffer.resize(( size_t ) samplesPerBlock );
+    // transfer tables and harmonic masks are rebuilt on a background thread during playback,
+    // when rendering offline they are rebuilt on the audio thread so the output is deterministic
 
-    loPre.resize(( size_t ) samplesPerBlock );
-    hiPre.resize(( size_t ) samplesPerBlock );
-    inBuffer.resize(( size_t ) samplesPerBlock );
-    
-    // align values with model
-    updateParameters();
+    const bool useTables   = Parameters::Config::USE_TRANSFER_TABLES;
+    const bool synchronous = isNonRealtime();
+
+    fft.setSynchronous( synchronous );
+
+    for ( auto& band : bands ) {
+        band.waveShaper.setLookupTableEnabled( useTables );
+        band.waveShaper.setLookupTableSynchronous( synchronous );
+        band.waveFolder.setLookupTableEnabled( useTables );
+        band.waveFolder.setLookupTableSynchronous( synchronous );
+        band.fuzz.setLookupTableEnabled( useTables );
+        band.fuzz.setLookupTableSynchronous( synchronous );
+    }
+
+    // align values with model (the smoothers are at their target values, so the modules are updated explicitly)
+    presets.applyPendingSelection();
+    parameterListener.drain();
+    updateParameters( ~ParameterListener::Mask( 0 ));
+    applyParameters( true );
+
+    // the latency is reported right away (rather than on the message thread), so it is known before processing starts
+
+    cancelPendingUpdate();
+    setLatencySamples( latencySamples.load());
+}
+
+int AudioPluginAudioProcessor::getFFTOrder() const
+{
+    const int sizeIndex = static_cast<int>( fftSize->load());
+
+    if ( sizeIndex == 0 ) {
+        return FFT::getAutomaticOrder( getSampleRate() > 0.0 ? getSampleRate() : Parameters::FFT::REFERENCE_SAMPLE_RATE );
+    }
+    return Parameters::FFT::MIN_ORDER + sizeIndex - 1;
+}
+
+int AudioPluginAudioProcessor::getFFTOverlap() const
+{
+    return static_cast<int>( fftOverlap->load()) == 0 ? 2 : 4;
+}
+
+void AudioPluginAudioProcessor::setRandomSeed( juce::uint32 seed )
+{
+    randomSeed = seed;
+}
+
+void AudioPluginAudioProcessor::setParallelProcessing( bool enabled )
+{
+    parallelProcessing = enabled;
 }
 
 void AudioPluginAudioProcessor::releaseResources()
@@ -337,146 +621,573 @@ void AudioPluginAudioProcessor::processBlock( juce::AudioBuffer<float>& buffer,
 {
     juce::ignoreUnused( midiMessages );
     juce::ScopedNoDenormals noDenormals;
+
+    // the tempo and song position the LFOs are synced to (their cycle lengths follow the time signature)
+
+    if ( auto* currentPlayHead = getPlayHead()) {
+        const auto positionInfo = currentPlayHead->getPosition();
+
+        if ( positionInfo.hasValue() && alignWithSequencer( positionInfo )) {
+            updateModulation();
+        }
+    }
+
+    // hosts can provide blocks exceeding the block size announced to prepareToPlay() (e.g. when bouncing offline). As all
+    // buffers are sized for the prepared block size, these are processed as consecutive sub blocks of up to that size
+
+    const int numSamples = buffer.getNumSamples();
+
+    if ( preparedBlockSize <= 0 || numSamples <= preparedBlockSize ) {
+        processSubBlock( buffer );
+        return;
+    }
+
+    // the sub blocks refer to the channel data of the buffer, channels beyond MAX_CHANNELS pass through regardless
+    // (and are omitted, so the sub blocks fit their preallocated channel list and don't allocate)
+
+    const int numChannels = juce::jmin( buffer.getNumChannels(), MAX_CHANNELS );
+
+    for ( int offset = 0; offset < numSamples; offset += preparedBlockSize ) {
+        const int subBlockSize = juce::jmin( preparedBlockSize, numSamples - offset );
+        juce::AudioBuffer<float> subBlock( buffer.getArrayOfWritePointers(), numChannels, offset, subBlockSize );
+
+        processSubBlock( subBlock );
+
+        if ( songPosition >= 0.0 ) {
+            songPosition += static_cast<double>( subBlockSize ) / getSampleRate() * tempo / 60.0;
+        }
+    }
+}
+
+void AudioPluginAudioProcessor::processSubBlock( juce::AudioBuffer<float>& buffer )
+{
+    // when profiling, the time spent on the stages processed on the audio thread is measured here, the stages
+    // processed per channel are measured per lane (see Profiler)
+
+    const bool profiling = profiler.isEnabled();
+    const juce::int64 blockStartTicks = profiling ? juce::Time::getHighResolutionTicks() : 0;
+    Profiler::StageTicks stageTicks {};
+    Profiler::StageTicks* blockStageTicks = profiling ? &stageTicks : nullptr;
   
-    int channelAmount = buffer.getNumChannels();
+    // channels exceeding the prepared layout (should the host not call prepareToPlay() after changing it) pass through
+
+    int channelAmount = juce::jmin( buffer.getNumChannels(), static_cast<int>( channelContexts.size()));
     int bufferSize = buffer.getNumSamples();
-    auto uBufferSize = static_cast<unsigned long>( bufferSize );
+
+    // apply the parameter changes since the last block (on the audio thread only, so the modules are never
+    // updated while processing), any amount of changes in between blocks results in a single update. A program
+    // selected since the last block is applied onto the raw parameter values first, so all of its values arrive in this block
+
+    const auto changedParameters = presets.applyPendingSelection() | parameterListener.drain();
+    const bool forceApply        = changedParameters != 0 && updateParameters( changedParameters );
+
+    // idle channels are re-evaluated after a parameter change (as some distortions generate a signal out of silence)
+
+    if ( changedParameters != 0 ) {
+        for ( auto& context : channelContexts ) {
+            context.idle = false;
+        }
+    }
 
     // prepare gain staging
 
     float dryMix = 1.f - *dryWetMix;
     float wetMix = *dryWetMix;
-    bool blendDry = dryMix > 0.f;
-    bool needsFiltering = loDistType == Parameters::DistortionType::WaveFolder ||
-        ( !ParameterUtilities::floatToBool( *linkEnabled ) && hiDistType == Parameters::DistortionType::WaveFolder );
-    
+
     // update module properties with smoothed changes to prevent crackling
 
-    applyParameters( bufferSize, false );
+    smoothers.process( bufferSize );
 
-    // per channel processing
+    // render the modulation of this block at control rate (the envelope follows the input of all channels), the
+    // modules of the targets that are modulated are updated with their modulated values
 
-    for ( int channel = 0; channel < channelAmount; ++channel )
-    {
-        if ( buffer.getReadPointer( channel ) == nullptr ) {
+    modulation.process( buffer.getArrayOfReadPointers(), channelAmount, bufferSize, tempo, songPosition, isPlaying );
+    applyParameters( forceApply );
+
+    // when switching to the harmonic split mode or changing its FFT configuration, discard the frames of its previous use
+
+    const auto currentSplitMode = splitMode.load();
+    if ( currentSplitMode == Parameters::SplitMode::Harmonic ) {
+        const bool reconfigured = fft.configure( getFFTOrder(), getFFTOverlap());
+
+        if ( reconfigured || currentSplitMode != activeSplitMode ) {
+            for ( auto& context : channelContexts ) {
+                context.fftState.reset();
+            }
+        }
+
+        // note we use splitFreq (the target of the smoothed split frequency) instead of the current smoothed value as
+        // masks are built asynchronously, this only requests a new mask when one of the values has changed. While modulated,
+        // the frequency is quantized so that a new mask is only requested once the highest harmonic has moved by half a bin
+
+        const int numHarmonics = juce::jmax( 1, static_cast<int>( harmonicCount->load()));
+        float harmonicFrequency = splitFreq->load();
+
+        if ( modulation.isModulated( ModulationMatrix::SplitFrequency )) {
+            const float step = static_cast<float>( getSampleRate() / fft.getSize()) / ( 2.f * static_cast<float>( numHarmonics ));
+            harmonicFrequency = juce::jlimit(
+                Parameters::Ranges::SPLIT_FREQ_MIN, static_cast<float>( getSampleRate() * 0.45 ),
+                std::round( harmonicFrequency * splitModulation / step ) * step
+            );
+        }
+        fft.setHarmonics( harmonicFrequency, numHarmonics, harmonicWidth->load(), harmonicFalloff->load());
+        fft.update();
+    }
+    activeSplitMode = currentSplitMode;
+
+    // the harmonic split always uses two bands (the low and high slot)
+
+    const int activeBands = currentSplitMode == Parameters::SplitMode::EQ ? numBands : 2;
+    bool needsFiltering = false;
+
+    for ( int band = 0; band < activeBands; ++band ) {
+        needsFiltering |= bands[ ( size_t ) getSlot( band, activeBands )].type == Parameters::DistortionType::WaveFolder;
+    }
+
+    // the oversampling of the band distortion (EQ split only), changing the factor resets the oversampling filters
+
+    const int oversamplingOrder = static_cast<int>( oversampling->load());
+
+    for ( auto& context : channelContexts ) {
+        if ( context.oversamplers[ 0 ].getOrder() == oversamplingOrder ) {
             continue;
         }
+        for ( auto& oversampler : context.oversamplers ) {
+            oversampler.setOrder( oversamplingOrder );
+        }
+        for ( auto& bitCrusher : context.bitCrushers ) {
+            bitCrusher.setOversampling( context.oversamplers[ 0 ].getFactor());
+        }
+    }
 
-        int channelNum = channel % MAX_CHANNELS; // keep in range of modules allocated to MAX_CHANNELS
-        auto* channelData = buffer.getWritePointer( channel );
-            
-        // process mode 1: EQ based split
+    // when oversampling, the harmonics above the host Nyquist frequency have been filtered out already. Where the
+    // host Nyquist frequency doesn't exceed the low-pass cutoff (e.g. at low sample rates) there is no ultrasonic
+    // content left and its removal can be omitted (leaving only the removal of the DC offset). At higher sample rates
+    // the content between the cutoff and the host Nyquist frequency remains, and is removed regardless of oversampling
 
-        if ( splitMode == Parameters::SplitMode::EQ ) {
+    const bool isOversampling = currentSplitMode == Parameters::SplitMode::EQ && oversamplingOrder > 0;
+    const bool omitLowPass    = isOversampling && !DCFilter::hasUltrasonicRange( getSampleRate());
 
-            auto channelBuffer = buffer.getReadPointer( channel );
-            auto lo = loBuffer.data();
-            auto hi = hiBuffer.data();
-            
-            std::memcpy( lo, channelBuffer, sizeof( float ) * uBufferSize );
-            std::memcpy( hi, channelBuffer, sizeof( float ) * uBufferSize );
+    dcFilter.setMode( omitLowPass ? DCFilter::Mode::DCBlock : DCFilter::Mode::DCBlockAndLowPass );
 
-            // apply Linkwitz–Riley filtering for a clean crossover separation
+    // pick up rebuilt transfer tables (from here on the modules are only read during this block). The curve of a modulated
+    // slot changes every block, rather than continuously rebuilding its table, it is computed directly
 
-            juce::dsp::AudioBlock<float> loBlock( &lo, 1, uBufferSize );
-            juce::dsp::AudioBlock<float> hiBlock( &hi, 1, uBufferSize );
+    for ( size_t slot = 0; slot < bands.size(); ++slot ) {
+        auto& band = bands[ slot ];
+        const bool useTable = Parameters::Config::USE_TRANSFER_TABLES && !isModulated( getSource(( int ) slot ));
 
-            loPass[ channelNum ].process( juce::dsp::ProcessContextReplacing<float>( loBlock ));
-            hiPass[ channelNum ].process( juce::dsp::ProcessContextReplacing<float>( hiBlock ));
+        band.waveShaper.setLookupTableEnabled( useTable );
+        band.waveFolder.setLookupTableEnabled( useTable );
+        band.fuzz.setLookupTableEnabled( useTable );
 
-            // save the pre-distorted state of the filtered buffer...
+        band.waveShaper.updateLookupTable();
+        band.waveFolder.updateLookupTable();
+        band.fuzz.updateLookupTable();
+    }
 
-            std::memcpy( loPre.data(), lo, sizeof( float ) * uBufferSize );
-            std::memcpy( hiPre.data(), hi, sizeof( float ) * uBufferSize );
+    // the harmonic split distorts complete frames (which don't correspond to the samples of this block) using the
+    // values provided to the modules, the EQ split reads the per-sample values (at the oversampled rate when oversampling)
 
-            // ...distort
+    const bool useRamps = currentSplitMode == Parameters::SplitMode::EQ;
+    std::array<ParameterRamps, MAX_BANDS> rampStorage;
+    std::array<const ParameterRamps*, MAX_BANDS> ramps {};
 
-            applyDistortion( channel, lo, hi, uBufferSize, uBufferSize );
+    if ( useRamps && modulation.isActive()) {
+        renderModulation();
+    }
+
+    for ( int slot = 0; useRamps && slot < MAX_BANDS; ++slot ) {
+        ramps[ ( size_t ) slot ] = getRamps( rampStorage[ ( size_t ) slot ], getSource( slot ), oversamplingOrder );
+    }
 
-            // ...and apply make-up gain to keep large volume jumps in check
+    // per channel processing, each channel is an independent job that is distributed over the worker pool when
+    // the work per block is large enough to outweigh the cost of synchronisation (or processed serially otherwise)
+
+    const BlockSettings block {
+        bufferSize, dryMix, wetMix, currentSplitMode, numBands, ramps, getTailSamples( getSampleRate()), profiling, analysisTap.isActive()
+    };
+    float* const* channelPointers = buffer.getArrayOfWritePointers();
 
-            loMakeup[ channelNum ].apply( loPre.data(), lo, bufferSize );
-            hiMakeup[ channelNum ].apply( hiPre.data(), hi, bufferSize );
+    // silence detection (see processChannel()) and the crossover of the EQ split. The crossover splits all channels
+    // into bands at once (processing multiple channels side by side), channels that are idle and remain silent are skipped
 
-            // write the effected buffer into the output
-    
-            for ( int i = 0; i < bufferSize; ++i ) {
-                auto dry = channelData[ i ] * dryMix;
-                auto wet = ( lo[ i ] + hi[ i ]) * wetMix;
+    std::array<const float*, MAX_CHANNELS> crossoverInput {};
+    std::array<float*, MAX_CHANNELS * MAX_BANDS> crossoverBands {};
 
-                channelData[ i ] = MathUtilities::clamp( dry + wet );
+    for ( int channel = 0; channel < channelAmount; ++channel ) {
+        auto& context = channelContexts[ ( size_t ) channel ];
+        const float* channelData = channelPointers[ channel ];
+
+        context.silentInput = channelData == nullptr || isSilent( channelData, bufferSize );
+
+        crossoverInput[ ( size_t ) channel ] = context.silentInput && context.idle ? nullptr : channelData;
+        std::copy( context.bands.begin(), context.bands.end(), crossoverBands.begin() + channel * MAX_BANDS );
+    }
+
+    if ( currentSplitMode == Parameters::SplitMode::EQ ) {
+        Profiler::ScopedTimer timer( blockStageTicks, Profiler::Crossover );
+        crossover.process( crossoverInput.data(), crossoverBands.data(), channelAmount, bufferSize );
+    }
+
+    // publish the input and the bands of the first channel to the analysis tap (the harmonic split publishes its frames
+    // while splitting, see processChannel()). The bands of an idle channel were not written by the crossover and are silent
+
+    if ( block.analysing && currentSplitMode == Parameters::SplitMode::EQ && channelAmount > 0 && channelPointers[ 0 ] != nullptr ) {
+        const bool isSplit = crossoverInput[ 0 ] != nullptr;
+        analysisTap.pushSamples( channelPointers[ 0 ], isSplit ? crossoverBands.data() : nullptr, numBands, bufferSize );
+    }
+
+    for ( auto& lane : lanes ) {
+        lane.workTicks = 0;
+        lane.stageTicks.fill( 0 );
+    }
+
+    // the processing time of the channels is only measured to decide whether to distribute them over the worker pool
+    // (see updateWorkLoad()), without a worker pool the channels are always processed serially and it is not measured
+
+    const bool measureWorkLoad = workerPool != nullptr;
+
+    auto processJob = [ this, channelPointers, &block, measureWorkLoad ]( int channel, int laneIndex ) {
+        if ( channelPointers[ channel ] == nullptr ) {
+            return;
+        }
+        const juce::int64 startTicks = measureWorkLoad ? juce::Time::getHighResolutionTicks() : 0;
+        auto& lane = lanes[ ( size_t ) laneIndex ];
+
+        processChannel( ( size_t ) channel, lane, ( size_t ) laneIndex, channelPointers[ channel ], block );
+
+        if ( measureWorkLoad ) {
+            lane.workTicks += juce::Time::getHighResolutionTicks() - startTicks;
+        }
+    };
+
+    if ( workerPool != nullptr && useWorkerPool ) {
+        workerPool->run( channelAmount, processJob );
+    } else {
+        for ( int channel = 0; channel < channelAmount; ++channel ) {
+            processJob( channel, 0 );
+        }
+    }
+
+    // certain processes can benefit from removing ultra- and infrasonic noise from the signal, the filter
+    // processes all channels at once (multiple channels side by side), channels that have become idle are skipped
+
+    if ( needsFiltering ) {
+        Profiler::ScopedTimer timer( blockStageTicks, Profiler::DCFilter );
+        std::array<float*, MAX_CHANNELS> filterChannels {};
+
+        for ( int channel = 0; channel < channelAmount; ++channel ) {
+            filterChannels[ ( size_t ) channel ] = channelContexts[ ( size_t ) channel ].idle ? nullptr : channelPointers[ channel ];
+        }
+        dcFilter.process( filterChannels.data(), channelAmount, bufferSize );
+    }
+
+    if ( measureWorkLoad ) {
+        updateWorkLoad();
+    }
+
+    if ( profiling ) {
+        for ( const auto& lane : lanes ) {
+            for ( size_t stage = 0; stage < stageTicks.size(); ++stage ) {
+                stageTicks[ stage ] += lane.stageTicks[ stage ];
             }
         }
-        else {
-            // process mode 2: harmonic bin splitting
+        profiler.record( stageTicks, juce::Time::getHighResolutionTicks() - blockStartTicks, bufferSize, getSampleRate());
+    }
+}
 
-            auto& channelState = channelStates[ ( size_t ) channelNum ];
+void AudioPluginAudioProcessor::processChannel( size_t channel, Lane& lane, size_t laneIndex, float* channelData, const BlockSettings& block )
+{
+    auto& context = channelContexts[ channel ];
 
-            std::memcpy( inBuffer.data(), channelData, sizeof( float ) * uBufferSize );
+    const int bufferSize   = block.bufferSize;
+    const auto uBufferSize = static_cast<unsigned long>( bufferSize );
 
-            // note we use splitFreq (the target of splitFreqSmoothed) instead of the current
-            // smoothed value to prevent calculation overhead, this (non-interpolated) value is safe for masking
+    // silence detection : once the input has been silent for the length of the tail (e.g. all delayed input has
+    // been flushed) and the output has decayed to silence, the channel state is cleared and processing is skipped
 
-            fft.calculateHarmonics( splitFreq->load() );
-            
-            unsigned long samplesProcessed = 0;
-            while ( samplesProcessed < uBufferSize )
-            {
-                // Write new input into circular inputBuffer
-                const unsigned long samplesToCopy = std::min( Parameters::FFT::HOP_SIZE, uBufferSize - samplesProcessed );
-                std::memmove(
-                    channelState.inputBuffer.data(), channelState.inputBuffer.data() + Parameters::FFT::HOP_SIZE, ( Parameters::FFT::SIZE - Parameters::FFT::HOP_SIZE ) * sizeof( float )
-                );
-                std::memcpy(
-                    channelState.inputBuffer.data() + ( Parameters::FFT::SIZE - Parameters::FFT::HOP_SIZE ), channelData + samplesProcessed, static_cast<unsigned long>( samplesToCopy ) * sizeof( float )
-                );
+    const bool silentInput = context.silentInput;
 
-                // apply FFT to split input signal into specA and specB by harmonic bins
+    if ( silentInput && context.idle ) {
+        juce::FloatVectorOperations::clear( channelData, bufferSize );
+        return;
+    }
+    context.idle = false;
+    context.silentSamples = silentInput ? juce::jmin( context.silentSamples + bufferSize, block.tailSamples ) : 0;
 
-                fft.split( channelState.inputBuffer, specA, specB );
+    // process mode 1: EQ based split
 
-                // distort
+    if ( block.splitMode == Parameters::SplitMode::EQ ) {
 
-                applyDistortion( channel, specA.data(), specB.data(), specA.size(), specB.size() );
+        // the bands as split by the Linkwitz-Riley crossover (see processBlock()) are processed in tiles, see processTile()
 
-                // sum and apply window (windowing ensures overlap-add works correctly)
+        for ( int offset = 0; offset < bufferSize; offset += TILE_SIZE ) {
+            processTile( context, channel, lane, channelData, offset, juce::jmin( TILE_SIZE, bufferSize - offset ), block );
+        }
+    }
+    else {
+        // process mode 2: harmonic bin splitting
 
-                fft.sum( channelState.outputBuffer, specA, specB );
+        auto& channelState = context.fftState;
 
-                // write samples to output
+        // inBuffer receives the input delayed by the latency of the split (e.g. aligned with the wet signal),
+        // which is the sample that is overwritten in the input ring
 
-                for ( size_t i = 0; i < Parameters::FFT::HOP_SIZE && ( samplesProcessed + i < uBufferSize ); ++i ) {
-                    channelData[ samplesProcessed + i ] = channelState.outputBuffer[ static_cast<unsigned long>( i )] * wetMix;
-                }
+        float* dry = lane.inBuffer.data();
+        const auto frameSize = static_cast<unsigned long>( fft.getSize());
+        const auto hopSize = static_cast<unsigned long>( fft.getHopSize());
+        unsigned long samplesProcessed = 0;
+
+        while ( samplesProcessed < uBufferSize )
+        {
+            // process up to the next hop boundary (as the FFT size is a multiple of the hop size
+            // the boundaries coincide with the end of the rings, so a run never wraps)
+
+            const unsigned long samplesToProcess = std::min(
+                hopSize - channelState.hopPosition, uBufferSize - samplesProcessed
+            );
+            float* input  = channelState.inputRing  + channelState.position;
+            float* output = channelState.outputRing + channelState.position;
+            float* data   = channelData + samplesProcessed;
+
+            for ( size_t i = 0; i < samplesToProcess; ++i ) {
+                dry[ samplesProcessed + i ] = input[ i ];
+                input[ i ]  = data[ i ];
+                data[ i ]   = output[ i ] * block.wetMix;
+                output[ i ] = 0.f;
+            }
+            channelState.position     = ( channelState.position + samplesToProcess ) % frameSize;
+            channelState.hopPosition += samplesToProcess;
+            samplesProcessed         += samplesToProcess;
+
+            if ( channelState.hopPosition < hopSize ) {
+                continue;
+            }
+            channelState.hopPosition = 0;
+
+            // the input ring now holds a complete frame, of which the oldest sample is at the current position
+            // apply FFT to split input signal into specA and specB by harmonic bins
+
+            {
+                Profiler::ScopedTimer timer( getStageTicks( lane, block ), Profiler::FFTSplit );
+                fft.split( channelState.inputRing, channelState.position, lane.specA, lane.specB, laneIndex );
+            }
+            if ( block.analysing && channel == 0 ) {
+                analysisTap.pushSpectrum( fft.getSpectrum( laneIndex ), fft.getSize(), fft.getSpectrumScale(), fft.getMask());
+            }
+
+            // distort
+
+            {
+                Profiler::ScopedTimer timer( getStageTicks( lane, block ), Profiler::Distortion );
+                applyDistortion( context, LO_SLOT, lane.specA.data(), frameSize, nullptr );
+                applyDistortion( context, HI_SLOT, lane.specB.data(), frameSize, nullptr );
+            }
+
+            // sum and apply window (windowing ensures overlap-add works correctly)
+
+            fft.sum( channelState.outputRing, channelState.position, lane.specA, lane.specB );
+        }
+
+        // apply make-up gain to keep large volume jumps in check
 
-                // shift output buffer for next overlap
-
-                std::memmove(
-                    channelState.outputBuffer.data(), channelState.outputBuffer.data() + Parameters::FFT::HOP_SIZE,
-                    ( Parameters::FFT::SIZE - Parameters::FFT::HOP_SIZE ) * sizeof( float )
-                );
-                std::fill(
-                    channelState.outputBuffer.begin() + static_cast<long>( Parameters::FFT::SIZE - Parameters::FFT::HOP_SIZE ),
-                    channelState.outputBuffer.end(), 0.0f
-                );
-                samplesProcessed += Parameters::FFT::HOP_SIZE;
+        {
+            Profiler::ScopedTimer timer( getStageTicks( lane, block ), Profiler::MakeUp );
+            context.makeup[ LO_SLOT ].analyse( dry, bufferSize );
+            context.makeup[ LO_SLOT ].apply( channelData, bufferSize );
+        }
+
+        if ( block.dryMix > 0.f ) {
+            for ( size_t i = 0; i < uBufferSize; ++i ) {
+                channelData[ i ] += ( dry[ i ] * block.dryMix );
             }
+        }
+    }
+
+    if ( silentInput && context.silentSamples >= block.tailSamples && isSilent( channelData, bufferSize )) {
+        resetChannel( channel );
+        context.idle = true;
+    }
+}
+
+void AudioPluginAudioProcessor::processTile( ChannelContext& context, size_t channel, Lane& lane, float* channelData, int offset, int tileSize, const BlockSettings& block )
+{
+    const int numBands = block.numBands;
+    const auto uTileSize = static_cast<unsigned long>( tileSize );
+
+    std::array<float*, MAX_BANDS> bandData;
+    for ( int band = 0; band < numBands; ++band ) {
+        bandData[ ( size_t ) band ] = context.bands[ ( size_t ) band ] + offset;
+    }
+
+    // the per-sample parameter values of the tile (when interpolating)
+
+    std::array<ParameterRamps, MAX_BANDS> rampStorage;
+    std::array<const ParameterRamps*, MAX_BANDS> ramps {};
+
+    for ( size_t slot = 0; slot < ( size_t ) MAX_BANDS; ++slot ) {
+        if ( block.ramps[ slot ] != nullptr ) {
+            rampStorage[ slot ] = block.ramps[ slot ]->from(( size_t ) offset );
+            ramps[ slot ] = &rampStorage[ slot ];
+        }
+    }
 
-            // apply make-up gain to keep large volume jumps in check
+    Profiler::StageTicks* stageTicks = getStageTicks( lane, block );
 
-            loMakeup[ channelNum ].apply( inBuffer.data(), channelData, bufferSize );
+    // measure the level of the bands prior to distortion...
 
-            if ( blendDry ) {
-                for ( size_t i = 0; i < uBufferSize; ++i ) {
-                    channelData[ i ] += ( inBuffer[ i ] * dryMix );
+    {
+        Profiler::ScopedTimer timer( stageTicks, Profiler::MakeUp );
+
+        for ( int band = 0; band < numBands; ++band ) {
+            context.makeup[ ( size_t ) getSlot( band, numBands )].analyse( bandData[ ( size_t ) band ], tileSize );
+        }
+    }
+
+    // ...distort (when oversampling, at the higher sample rate, the bands are up- and downsampled in pairs, an
+    // uneven last band is paired with a silent spare)...
+
+    {
+        Profiler::ScopedTimer timer( stageTicks, Profiler::Distortion );
+
+        for ( int band = 0; band < numBands; band += 2 ) {
+            auto& oversampler = context.oversamplers[ ( size_t ) ( band / 2 )];
+            const bool hasPair = band + 1 < numBands;
+
+            const int loSlot = getSlot( band, numBands );
+            const int hiSlot = hasPair ? getSlot( band + 1, numBands ) : HI_SLOT;
+            float* lo = bandData[ ( size_t ) band ];
+            float* hi = hasPair ? bandData[ ( size_t ) ( band + 1 )] : lane.spareBand.data();
+
+            if ( oversampler.getOrder() > 0 ) {
+                if ( !hasPair ) {
+                    juce::FloatVectorOperations::clear( hi, tileSize );
+                }
+                const size_t index = oversampler.upsample( lo, hi, tileSize, lane.oversampled );
+                const auto oversampledSize = uTileSize * static_cast<unsigned long>( oversampler.getFactor());
+
+                applyDistortion( context, loSlot, lane.oversampled.lo[ index ].data(), oversampledSize, ramps[ ( size_t ) loSlot ]);
+
+                if ( hasPair ) {
+                    applyDistortion( context, hiSlot, lane.oversampled.hi[ index ].data(), oversampledSize, ramps[ ( size_t ) hiSlot ]);
+                }
+                oversampler.downsample( lane.oversampled, index, lo, hi, tileSize );
+            } else {
+                applyDistortion( context, loSlot, lo, uTileSize, ramps[ ( size_t ) loSlot ]);
+
+                if ( hasPair ) {
+                    applyDistortion( context, hiSlot, hi, uTileSize, ramps[ ( size_t ) hiSlot ]);
                 }
             }
         }
-        // certain processes can benefit from removing ultra- and infrasonic noise from the signal
-        if ( needsFiltering ) {
-            dcFilters[ channelNum ].apply( channelData, uBufferSize );
+    }
+
+    // ...apply make-up gain to keep large volume jumps in check...
+
+    {
+        Profiler::ScopedTimer timer( stageTicks, Profiler::MakeUp );
+
+        for ( int band = 0; band < numBands; ++band ) {
+            context.makeup[ ( size_t ) getSlot( band, numBands )].apply( bandData[ ( size_t ) band ], tileSize );
         }
     }
+
+    // ...and sum the bands into the first band, aligning the phase of the lower bands with the bands above (see Crossover::compensate())
+
+    float* wetData = bandData[ 0 ];
+    {
+        Profiler::ScopedTimer timer( stageTicks, Profiler::Crossover );
+
+        for ( int band = 1; band < numBands; ++band ) {
+            if ( band < numBands - 1 ) {
+                crossover.compensate(( int ) channel, band, wetData, tileSize );
+            }
+            const float* data = bandData[ ( size_t ) band ];
+
+            for ( int i = 0; i < tileSize; ++i ) {
+                wetData[ i ] += data[ i ];
+            }
+        }
+    }
+
+    // write the effected tile into the output (the dry signal is delayed by the latency of the oversampling)
+
+    float* outputData  = channelData + offset;
+    const float* dryData = outputData;
+    auto& oversampler  = context.oversamplers[ 0 ]; // all bands share the same latency
+
+    if ( oversampler.getLatencySamples() > 0 ) {
+        float* delayed = lane.inBuffer.data() + offset;
+
+        std::memcpy( delayed, outputData, sizeof( float ) * uTileSize );
+        oversampler.delay( delayed, tileSize );
+        dryData = delayed;
+    }
+
+    for ( int i = 0; i < tileSize; ++i ) {
+        auto dry = dryData[ i ] * block.dryMix;
+        auto wet = wetData[ i ] * block.wetMix;
+
+        outputData[ i ] = MathUtilities::clamp( dry + wet );
+    }
+}
+
+void AudioPluginAudioProcessor::resetChannel( size_t channel )
+{
+    auto& context = channelContexts[ channel ];
+
+    crossover.reset(( int ) channel );
+    dcFilter.reset(( int ) channel );
+    for ( auto& bitCrusher : context.bitCrushers ) {
+        bitCrusher.reset();
+    }
+    for ( auto& state : context.antiAliasing ) {
+        state.reset();
+    }
+    for ( auto& oversampler : context.oversamplers ) {
+        oversampler.reset();
+    }
+    context.fftState.reset();
+}
+
+const ParameterRamps* AudioPluginAudioProcessor::getRamps( ParameterRamps& ramps, int slot, int shift ) const
+{
+    const int level = getLevelIndex( slot );
+
+    if ( !isModulated( slot ) && !smoothers.isSmoothing( level, level + 2 )) {
+        return nullptr;
+    }
+    const int driveTarget = ModulationMatrix::getDriveTarget( slot );
+    const int paramTarget = ModulationMatrix::getParamTarget( slot );
+
+    ramps.level = smoothers.getRamp( level );
+    ramps.drive = modulation.isModulated( driveTarget ) ? getModulationRamp( driveTarget ) : smoothers.getRamp( level + 1 );
+    ramps.param = modulation.isModulated( paramTarget ) ? getModulationRamp( paramTarget ) : smoothers.getRamp( level + 2 );
+    ramps.shift = shift;
+
+    return &ramps;
+}
+
+void AudioPluginAudioProcessor::updateWorkLoad()
+{
+    // the combined processing time of all channels (e.g. the duration of serial processing)
+
+    juce::int64 workTicks = 0;
+    for ( const auto& lane : lanes ) {
+        workTicks += lane.workTicks;
+    }
+    const double workMicros = juce::Time::highResolutionTicksToSeconds( workTicks ) * 1000000.0;
+    averageWorkMicros += ( workMicros - averageWorkMicros ) * WORK_LOAD_SMOOTHING;
+
+    // process in parallel above the threshold and serially below half of it (so the mode doesn't toggle
+    // when hovering around the threshold, as dispatching to the workers adds some overhead of its own)
+
+    if ( !useWorkerPool && averageWorkMicros > PARALLEL_THRESHOLD_MICROS ) {
+        useWorkerPool = true;
+    } else if ( useWorkerPool && averageWorkMicros < PARALLEL_THRESHOLD_MICROS * 0.5 ) {
+        useWorkerPool = false;
+    }
 }
 
 /* editor */
@@ -493,16 +1204,25 @@ juce::AudioProcessorEditor* AudioPluginAudioProcessor::createEditor()
 
 /* persistence */
 
+// the index of the selected program, stored alongside the parameters
+
+static const juce::Identifier PROGRAM_PROPERTY( "program" );
+
 void AudioPluginAudioProcessor::getStateInformation( juce::MemoryBlock& destData )
 {
+    auto state = parameters.copyState();
+    state.setProperty( PROGRAM_PROPERTY, presets.getSelected(), nullptr );
+
     juce::MemoryOutputStream stream( destData, true );
-    parameters.state.writeToStream( stream );
+    state.writeToStream( stream );
 }
 
 void AudioPluginAudioProcessor::setStateInformation( const void* data, int sizeInBytes )
 {
     juce::ValueTree tree = juce::ValueTree::readFromData( data, static_cast<unsigned long>( sizeInBytes ));
     if ( tree.isValid()) {
+        loadUserPrograms(); // the restored program can be a user preset
+        presets.setSelected( tree.getProperty( PROGRAM_PROPERTY, 0 ));
         parameters.state = tree;
     }
 }
@@ -527,6 +1247,9 @@ bool AudioPluginAudioProcessor::alignWithSequencer( juce::Optional<juce::AudioPl
 
     auto curTempo = positionInfo->getBpm();
     auto timeSig  = positionInfo->getTimeSignature();
+    auto position = positionInfo->getPpqPosition();
+
+    songPosition = position.hasValue() ? *position : -1.0;
 
     if ( curTempo.hasValue() && !juce::approximatelyEqual( tempo, *curTempo )) {
         tempo = *curTempo;
@@ -17,20 +17,27 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "modules/analysis/AnalysisTap.h"
 #include "modules/bitcrusher/Bitcrusher.h"
+#include "modules/crossover/Crossover.h"
 #include "modules/dcfilter/DCFilter.h"
 #include "modules/fft/FFT.h"
 #include "modules/fuzz/Fuzz.h"
 #include "modules/gain/AutoMakeUpGain.h"
-#include "modules/smoother/Smoother.h"
+#include "modules/modulation/ModulationMatrix.h"
+#include "modules/oversampler/Oversampler.h"
+#include "modules/smoother/ParameterRamps.h"
+#include "modules/smoother/SmootherBank.h"
 #include "modules/wavefolder/Wavefolder.h"
 #include "modules/waveshaper/Waveshaper.h"
+#include "presets/PresetBank.h"
 #include "utils/ParameterUtilities.h"
+#include "utils/Profiler.h"
+#include "utils/WorkerPool.h"
 #include "Parameters.h"
 #include "ParameterListener.h"
-#include "ParameterSubscriber.h"
 
-class AudioPluginAudioProcessor final : public juce::AudioProcessor, ParameterSubscriber
+class AudioPluginAudioProcessor final : public juce::AudioProcessor, private juce::AsyncUpdater
 {
     public:
         AudioPluginAudioProcessor();
@@ -54,11 +61,27 @@ class AudioPluginAudioProcessor final : public juce::AudioProcessor, ParameterSu
         const juce::String getProgramName( int index ) override;
         void changeProgramName( int index, const juce::String& newName ) override;
 
+        // stores the current parameter values as a new user program (see PresetBank), returns its index or -1 when
+        // the bank is full. To be invoked on the message thread
+        int saveProgram( const juce::String& name );
+
+        // the programs at and beyond this index are user presets (which can be renamed)
+        int getNumFactoryPrograms() const { return presets.getNumFactoryPresets(); }
+
         /* resource management */
 
         void prepareToPlay( double sampleRate, int samplesPerBlock ) override;
         void releaseResources() override;
 
+        // seeds the random generators of all modules, applied on the next prepareToPlay() call. Equal
+        // seeds (and parameters) produce identical output, e.g. for reproducible offline renders
+        void setRandomSeed( juce::uint32 seed );
+
+        // when enabled, channels are processed in parallel on a small pool of worker threads whenever the processing load
+        // per block is high enough to benefit from it (e.g. large blocks, high sample rates and channel counts), applied
+        // on the next prepareToPlay() call
+        void setParallelProcessing( bool enabled );
+
         /* rendering */
 
         void processBlock( juce::AudioBuffer<float>&, juce::MidiBuffer& ) override;
@@ -68,8 +91,6 @@ class AudioPluginAudioProcessor final : public juce::AudioProcessor, ParameterSu
 
         juce::AudioProcessorValueTreeState parameters;
         ParameterListener parameterListener;
-        void updateParameters() override;
-        void applyParameters( int samplesToAdvance, bool forceApply );
 
         static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
         {
@@ -90,6 +111,70 @@ class AudioPluginAudioProcessor final : public juce::AudioProcessor, ParameterSu
             params.push_back(
                 std::make_unique<juce::AudioParameterFloat>( Parameters::DRY_WET_MIX, "Dry/wet mix", 0.f, 1.f, 1.f )
             );
+            params.push_back(
+                std::make_unique<juce::AudioParameterChoice>(
+                    Parameters::FFT_SIZE, "FFT size", ParameterUtilities::getFFTSizeNames(), Parameters::Config::FFT_SIZE_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterChoice>(
+                    Parameters::FFT_OVERLAP, "FFT overlap", ParameterUtilities::getFFTOverlapNames(), Parameters::Config::FFT_OVERLAP_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterInt>(
+                    Parameters::HARMONIC_COUNT, "Harmonic count",
+                    Parameters::Ranges::HARMONIC_COUNT_MIN, Parameters::Ranges::HARMONIC_COUNT_MAX, Parameters::Config::HARMONIC_COUNT_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterFloat>(
+                    Parameters::HARMONIC_WIDTH, "Harmonic width",
+                    Parameters::Ranges::HARMONIC_WIDTH_MIN, Parameters::Ranges::HARMONIC_WIDTH_MAX, Parameters::Config::HARMONIC_WIDTH_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterFloat>(
+                    Parameters::HARMONIC_FALLOFF, "Harmonic falloff",
+                    Parameters::Ranges::HARMONIC_FALLOFF_MIN, Parameters::Ranges::HARMONIC_FALLOFF_MAX, Parameters::Config::HARMONIC_FALLOFF_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterChoice>(
+                    Parameters::ANTI_ALIASING, "Anti-aliasing",
+                    ParameterUtilities::getAntiAliasingNames(), Parameters::Config::ANTI_ALIASING_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterChoice>(
+                    Parameters::OVERSAMPLING, "Oversampling",
+                    ParameterUtilities::getOversamplingNames(), Parameters::Config::OVERSAMPLING_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterInt>(
+                    Parameters::BAND_COUNT, "Band count",
+                    Parameters::Ranges::BAND_COUNT_MIN, Parameters::Ranges::BAND_COUNT_MAX, Parameters::Config::BAND_COUNT_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterFloat>(
+                    Parameters::SPLIT_FREQ_2, "Split frequency 2",
+                    Parameters::Ranges::SPLIT_FREQ_MIN, Parameters::Ranges::UPPER_SPLIT_FREQ_MAX, Parameters::Config::SPLIT_FREQ_2_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterFloat>(
+                    Parameters::SPLIT_FREQ_3, "Split frequency 3",
+                    Parameters::Ranges::SPLIT_FREQ_MIN, Parameters::Ranges::UPPER_SPLIT_FREQ_MAX, Parameters::Config::SPLIT_FREQ_3_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterFloat>(
+                    Parameters::SPLIT_FREQ_4, "Split frequency 4",
+                    Parameters::Ranges::SPLIT_FREQ_MIN, Parameters::Ranges::UPPER_SPLIT_FREQ_MAX, Parameters::Config::SPLIT_FREQ_4_DEF
+                )
+            );
 
             // low band distortion
             params.push_back(
@@ -114,6 +199,29 @@ class AudioPluginAudioProcessor final : public juce::AudioProcessor, ParameterSu
                 )
             );
 
+            // mid band distortion (for band counts above two)
+
+            for ( int mid = 1; mid < Parameters::MAX_BANDS - 1; ++mid ) {
+                const auto& band = Parameters::BANDS[ mid ];
+                const juce::String name = "Mid " + juce::String( mid );
+
+                params.push_back(
+                    std::make_unique<juce::AudioParameterChoice>(
+                        band.type, name + " distortion type",
+                        ParameterUtilities::getDistortionTypeNames(), Parameters::Config::DIST_TYPE_DEF_MID
+                    )
+                );
+                params.push_back(
+                    std::make_unique<juce::AudioParameterFloat>( band.input, name + " Input level", 0.f, 1.f, Parameters::Config::DIST_INPUT_DEF )
+                );
+                params.push_back(
+                    std::make_unique<juce::AudioParameterFloat>( band.drive, name + " drive", 0.f, 1.f, Parameters::Config::DIST_DRIVE_DEF )
+                );
+                params.push_back(
+                    std::make_unique<juce::AudioParameterFloat>( band.param, name + " param", 0.f, 1.f, Parameters::Config::DIST_PARAM_DEF )
+                );
+            }
+
             // high band distortion
 
             params.push_back(
@@ -137,7 +245,52 @@ class AudioPluginAudioProcessor final : public juce::AudioProcessor, ParameterSu
                     Parameters::HI_DIST_PARAM, "Hi param", 0.f, 1.f, Parameters::Config::DIST_PARAM_DEF
                 )
             );
-            
+
+            // modulation sources
+
+            for ( int lfo = 0; lfo < Parameters::NUM_LFOS; ++lfo ) {
+                const auto& properties = Parameters::LFOS[ lfo ];
+                const juce::String name = "LFO " + juce::String( lfo + 1 );
+
+                params.push_back(
+                    std::make_unique<juce::AudioParameterChoice>(
+                        properties.rate, name + " rate", ParameterUtilities::getLFORateNames(), Parameters::Config::LFO_RATE_DEF
+                    )
+                );
+                params.push_back(
+                    std::make_unique<juce::AudioParameterChoice>( properties.shape, name + " shape", ParameterUtilities::getLFOShapeNames(), 0 )
+                );
+            }
+            params.push_back(
+                std::make_unique<juce::AudioParameterFloat>(
+                    Parameters::ENV_ATTACK, "Envelope attack",
+                    Parameters::Ranges::ENV_TIME_MIN, Parameters::Ranges::ENV_TIME_MAX, Parameters::Config::ENV_ATTACK_DEF
+                )
+            );
+            params.push_back(
+                std::make_unique<juce::AudioParameterFloat>(
+                    Parameters::ENV_RELEASE, "Envelope release",
+                    Parameters::Ranges::ENV_TIME_MIN, Parameters::Ranges::ENV_TIME_MAX, Parameters::Config::ENV_RELEASE_DEF
+                )
+            );
+
+            // modulation routes
+
+            for ( int route = 0; route < Parameters::NUM_ROUTES; ++route ) {
+                const auto& properties = Parameters::ROUTES[ route ];
+                const juce::String name = "Modulation " + juce::String( route + 1 );
+
+                params.push_back(
+                    std::make_unique<juce::AudioParameterChoice>( properties.source, name + " source", ParameterUtilities::getModulationSourceNames(), 0 )
+                );
+                params.push_back(
+                    std::make_unique<juce::AudioParameterChoice>( properties.target, name + " target", ParameterUtilities::getModulationTargetNames(), 0 )
+                );
+                params.push_back(
+                    std::make_unique<juce::AudioParameterFloat>( properties.depth, name + " depth", -1.f, 1.f, 0.f )
+                );
+            }
+
             return { params.begin(), params.end() };
         }
 
@@ -151,164 +304,375 @@ class AudioPluginAudioProcessor final : public juce::AudioProcessor, ParameterSu
         void getStateInformation( juce::MemoryBlock& destData ) override;
         void setStateInformation( const void* data, int sizeInBytes ) override;
         
+        /* diagnostics */
+
+        // the time spent per block on each processing stage (see Profiler), measured while the profiler is enabled
+        Profiler& getProfiler() { return profiler; }
+        const Profiler& getProfiler() const { return profiler; }
+
+        // the spectra of the input and the bands of the first channel, computed while a consumer is registered
+        AnalysisTap& getAnalysisTap() { return analysisTap; }
+
         /* runtime state */
 
         bool alignWithSequencer( juce::Optional<juce::AudioPlayHead::PositionInfo> positionInfo );
         
     private:
 
-        // crossover filter processing
+        // the largest supported amount of channels per bus (e.g. 7.1.4 immersive layouts and 16 channel discrete layouts)
 
-        static constexpr int MAX_CHANNELS = 2;
-        
-        juce::dsp::LinkwitzRileyFilter<float> loPass[ MAX_CHANNELS ];
-        juce::dsp::LinkwitzRileyFilter<float> hiPass[ MAX_CHANNELS ];
-        AutoMakeUpGain loMakeup[ MAX_CHANNELS ];
-        AutoMakeUpGain hiMakeup[ MAX_CHANNELS ];
-        DCFilter dcFilters[ MAX_CHANNELS ];
-        std::vector<float> loBuffer;
-        std::vector<float> hiBuffer;
+        static constexpr int MAX_CHANNELS = 16;
 
         // parameter smoothing (prevents glitches while adjusting in realtime)
 
         static constexpr float PARAM_RAMP_TIME_SECONDS = 0.02f;
-        
-        Smoother splitFreqSmoothed;
-        Smoother loLevelSmoothed;
-        Smoother loDriveSmoothed;
-        Smoother loParamSmoothed;
-        Smoother hiLevelSmoothed;
-        Smoother hiDriveSmoothed;
-        Smoother hiParamSmoothed;
-        
-        inline void prepareCrossoverFilter(
-            juce::dsp::LinkwitzRileyFilter<float> &filter, juce::dsp::LinkwitzRileyFilterType type, float frequency
-        ) {
-            filter.reset();
-            filter.setCutoffFrequency( frequency );
-            filter.setType( type );
+
+        // the distortion settings of the bands are kept in slots, in order of Parameters::BANDS : the first band of the EQ split
+        // uses the low slot, the last band the high slot and the bands in between the mid slots. The harmonic split uses
+        // the low and high slot. When the bands are linked, all slots use the settings of the low slot (see getSource())
+
+        static constexpr int MAX_BANDS = Parameters::MAX_BANDS;
+        static constexpr int LO_SLOT   = 0;
+        static constexpr int HI_SLOT   = MAX_BANDS - 1;
+
+        static inline int getSlot( int band, int numBands ) {
+            return band == numBands - 1 ? HI_SLOT : band;
         }
 
+        inline int getSource( int slot ) const {
+            return linkBands ? LO_SLOT : slot;
+        }
+
+        // the smoothed parameters, the split frequencies followed by the level, drive and param of each slot (which
+        // are consecutive, see ParameterRamps)
+
+        enum SmoothedParameter {
+            SplitFreq = 0,
+            BandLevel = SplitFreq + MAX_BANDS - 1,
+            NumSmoothedParameters = BandLevel + MAX_BANDS * 3
+        };
+        SmootherBank smoothers;
+
+        static inline int getLevelIndex( int slot ) {
+            return BandLevel + slot * 3;
+        }
+
+        // parameter changes are collected by the parameterListener and applied on the audio thread once per block.
+        // updateParameters() reads the parameters flagged in provided mask (returning whether the distortion or modulation
+        // of the slots changed), applyParameters() provides the modules with the (smoothed and modulated) values
+
+        bool updateParameters( ParameterListener::Mask changed );
+        void applyParameters( bool forceApply );
+
+        ParameterListener::Mask latencyFlags;
+
+        // the latency of the current split mode, as determined on the audio thread and reported to the host on the message thread
+        std::atomic<int> latencySamples { 0 };
+        void handleAsyncUpdate() override;
+        ParameterListener::Mask distTypeFlags;
+        ParameterListener::Mask bandCountFlags;
+        ParameterListener::Mask antiAliasingFlags;
+        ParameterListener::Mask smoothedFlags;
+        ParameterListener::Mask modulationFlags;
+
+        // the LFOs and envelope follower modulating the split frequencies and the drive and param of the slots,
+        // rendered once per block. Only the modules of the modulated slots are updated each block (see applyParameters())
+
+        ModulationMatrix modulation;
+        std::vector<float> modulationPool; // the per-sample values of the modulated drive and param targets (EQ split only)
+        size_t modulationRampSize = 0;
+        float splitModulation = 1.f; // the factor the split frequencies are multiplied by
+
+        // applies the modulation parameters and the time signature onto the modulation matrix
+        void updateModulation();
+
+        // renders the per-sample values of the modulated drive and param targets of the slots for the current block
+        void renderModulation();
+
+        inline float* getModulationRamp( int target ) {
+            return modulationPool.data() + static_cast<size_t>( target - 1 ) * modulationRampSize;
+        }
+
+        inline const float* getModulationRamp( int target ) const {
+            return modulationPool.data() + static_cast<size_t>( target - 1 ) * modulationRampSize;
+        }
+
+        inline bool isModulated( int slot ) const {
+            return modulation.isModulated( ModulationMatrix::getDriveTarget( slot )) || modulation.isModulated( ModulationMatrix::getParamTarget( slot ));
+        }
+
+        // the value of a smoothed parameter at the end of the last processed block, offset by the modulation of provided target
+        inline float getModulatedValue( int index, int target ) const {
+            const float value = smoothers.get( index );
+            return modulation.isModulated( target ) ? juce::jlimit( 0.f, 1.f, value + modulation.getValue( target )) : value;
+        }
+
+        // the factory and user programs, a program selected by the host is applied at the start of the next block
+
+        PresetBank presets;
+        bool userProgramsLoaded = false;
+
+        // reads the user presets into the bank, once and on the message thread only (see getNumPrograms())
+        void loadUserPrograms();
+
+        // the per-sample parameter values of a slot (while interpolating) or nullptr
+        const ParameterRamps* getRamps( ParameterRamps& ramps, int slot, int shift ) const;
+
+        // the crossover of the EQ split, splits all channels at once (see processBlock())
+
+        Crossover crossover;
+        int numBands = Parameters::Config::BAND_COUNT_DEF;
+
+        // applies the (ascending, modulated) split frequencies onto the crossover, only recomputing the coefficients of the
+        // splits that changed (the last applied frequencies are kept in crossoverFrequencies)
+        void updateCrossover();
+        std::array<float, MAX_BANDS - 1> crossoverFrequencies {};
+
+        inline float getSplitFrequency( int split ) const {
+            const float frequency = smoothers.get( SplitFreq + split );
+
+            if ( !modulation.isModulated( ModulationMatrix::SplitFrequency )) {
+                return frequency;
+            }
+            return juce::jmax( Parameters::Ranges::SPLIT_FREQ_MIN, frequency * splitModulation ); // the crossover clamps at the upper end
+        }
+
+        // removes the ultra- and infrasonic noise from all channels at once, after processing (see processBlock())
+        DCFilter dcFilter;
+
         // distortion modules, most are stateless w/regards to past inputs and can
-        // be reused across channels, with exception of BitCrusher
-
-        BitCrusher loBitCrusher[ MAX_CHANNELS ];
-        BitCrusher hiBitCrusher[ MAX_CHANNELS ];
-        Fuzz loFuzz;
-        Fuzz hiFuzz;
-        WaveFolder loWaveFolder;
-        WaveFolder hiWaveFolder;
-        WaveShaper loWaveShaper;
-        WaveShaper hiWaveShaper;
-
-        // read / write buffers
-
-        std::vector<float> loPre;
-        std::vector<float> hiPre;
-        std::vector<float> inBuffer;
-        std::vector<float> specA;
-        std::vector<float> specB;
-        
+        // be reused across channels, with exception of BitCrusher (see ChannelContext). When
+        // anti-aliasing is enabled, Fuzz and WaveFolder use the signal history of each channel (per band)
+
+        struct Band
+        {
+            Parameters::DistortionType type = Parameters::DistortionType::Off; // the type in use (e.g. of the source slot when linked)
+            std::atomic<float>* typeValue;
+            std::atomic<float>* inputLevel;
+            std::atomic<float>* drive;
+            std::atomic<float>* param;
+            Fuzz fuzz;
+            WaveFolder waveFolder;
+            WaveShaper waveShaper;
+        };
+        std::array<Band, MAX_BANDS> bands;
+        bool linkBands = false;
+
+        juce::uint32 randomSeed;
+
         // FFT processing
 
+        // Each channel is processed as a short-time Fourier transform with frames of fft.getSize() samples
+        // and a frame being processed once every fft.getHopSize() samples, regardless of the host block size.
+        // Input and output share a ring position : the output written to the ring at a position is read
+        // when the ring position returns there, e.g. the harmonic split has a latency of fft.getSize() samples.
+        // The rings are allocated for the largest FFT size, of which only the first fft.getSize() samples are used.
+
         struct ChannelState
         {
-            std::vector<float> inputBuffer;
-            std::vector<float> outputBuffer;
-            int writePos = 0;
-            bool initialised = false;
+            float* inputRing  = nullptr; // the most recent fft.getSize() input samples
+            float* outputRing = nullptr; // overlap-added output of the processed frames
+            size_t position    = 0; // read/write position within both rings
+            size_t hopPosition = 0; // amount of samples written since the last processed frame
+
+            void reset() {
+                std::fill( inputRing,  inputRing  + Parameters::FFT::MAX_SIZE, 0.f );
+                std::fill( outputRing, outputRing + Parameters::FFT::MAX_SIZE, 0.f );
+                position = hopPosition = 0;
+            }
         };
-        std::array<ChannelState, MAX_CHANNELS> channelStates;
         FFT fft;
+        Parameters::SplitMode activeSplitMode = Parameters::SplitMode::EQ; // mode of the last processed block
+
+        // All state that is specific to a single channel. The contexts are allocated as a single pool in prepareToPlay()
+        // to match the channel count of the bus layout (the FFT rings of all channels share the ringPool), so processing
+        // cost scales linearly with the channel count and the audio thread never allocates.
+
+        struct ChannelContext
+        {
+            std::array<float*, MAX_BANDS> bands {}; // the crossover output for the current block (see bandPool)
+
+            // per slot
+            std::array<AutoMakeUpGain, MAX_BANDS> makeup;
+            std::array<BitCrusher, MAX_BANDS> bitCrushers;
+            std::array<AntiAliasing::State, MAX_BANDS> antiAliasing;
+
+            // oversampling the bands in pairs (which all share the same order)
+            std::array<Oversampler, ( MAX_BANDS + 1 ) / 2> oversamplers;
+
+            ChannelState fftState;
+            bool silentInput  = false; // whether the input of the current block is silent
+            int silentSamples = 0; // amount of consecutive samples of silent input (up to the tail length)
+            bool idle = false;     // whether the input and the output have decayed to silence (see processChannel())
+        };
+        std::vector<ChannelContext> channelContexts;
+        std::vector<float> ringPool;
+        std::vector<float> bandPool;
+
+        // parallel processing, channels are processed as independent jobs on a lane (the audio thread or a worker),
+        // each lane has its own scratch buffers (aligned to prevent false sharing between the threads)
+
+        static constexpr int MAX_WORKERS = 3;
+        static constexpr double PARALLEL_THRESHOLD_MICROS = 250.0; // average work per block above which channels are processed in parallel
+        static constexpr double WORK_LOAD_SMOOTHING = 0.1;
+
+        struct alignas( 64 ) Lane
+        {
+            std::vector<float> spareBand; // pairs with the last band when oversampling an uneven amount of bands (one tile)
+            std::vector<float> inBuffer;  // the dry signal (delayed by the latency of the split or the oversampling)
+            std::vector<float> specA;
+            std::vector<float> specB;
+            Oversampler::Buffers oversampled; // a tile of a pair of bands at the oversampled rate
+            juce::int64 workTicks = 0; // time spent processing channels during the current block
+            Profiler::StageTicks stageTicks {}; // time spent per stage during the current block (while profiling)
+        };
+        std::vector<Lane> lanes;
+        std::unique_ptr<WorkerPool> workerPool;
+        bool parallelProcessing = Parameters::Config::PARALLEL_PROCESSING;
+        bool useWorkerPool = false;
+        double averageWorkMicros = 0.0;
+
+        // the EQ split processes each channel in tiles of up to TILE_SIZE samples, where each tile is distorted, gain
+        // compensated, summed and mixed into the output in one traversal while its bands are in cache. Must be a multiple
+        // of ParameterRamps::CHUNK_SIZE (so the chunks of ramped modules don't depend on the tiling)
+
+        static constexpr int TILE_SIZE = 256;
+
+        // the properties shared by all channels within a block
+
+        struct BlockSettings
+        {
+            int bufferSize;
+            float dryMix;
+            float wetMix;
+            Parameters::SplitMode splitMode;
+            int numBands;
+            std::array<const ParameterRamps*, MAX_BANDS> ramps; // the per-sample distortion parameters of each slot (EQ split only),
+                                                                // nullptr when not interpolating
+            int tailSamples; // see getTailSamples()
+            bool profiling;
+            bool analysing; // whether the analysis tap is active
+        };
+
+        // the block size provided to prepareToPlay(), processBlock() processes larger blocks in sub blocks of this size
+        int preparedBlockSize = 0;
+
+        // processes a block of up to preparedBlockSize samples
+        void processSubBlock( juce::AudioBuffer<float>& buffer );
+
+        void processChannel( size_t channel, Lane& lane, size_t laneIndex, float* channelData, const BlockSettings& block );
+
+        // processes a tile of the EQ split, starting at provided offset within the block
+        void processTile( ChannelContext& context, size_t channel, Lane& lane, float* channelData, int offset, int tileSize, const BlockSettings& block );
+
+        // clears all signal history of a channel (e.g. when it becomes idle)
+        void resetChannel( size_t channel );
+        void updateWorkLoad();
+
+        Profiler profiler;
+        AnalysisTap analysisTap;
+
+        // the stage counter of provided lane, nullptr when not profiling (see Profiler::ScopedTimer)
+        static inline Profiler::StageTicks* getStageTicks( Lane& lane, const BlockSettings& block ) {
+            return block.profiling ? &lane.stageTicks : nullptr;
+        }
+
+        // the FFT configuration as selected by the parameters
+        int getFFTOrder() const;
+        int getFFTOverlap() const;
+
+        int getLatencyForMode( Parameters::SplitMode mode ) const {
+            if ( mode == Parameters::SplitMode::Harmonic ) {
+                return 1 << getFFTOrder();
+            }
+            return static_cast<int>( std::round( Oversampler::getLatency( static_cast<int>( oversampling->load()))));
+        }
+
+        // silence detection, channels whose input has been silent for the length of the tail and whose output
+        // has decayed below SILENCE_THRESHOLD (-120 dBFS) are idle (e.g. skip processing until the input is no longer silent)
+
+        static constexpr float SILENCE_THRESHOLD  = 1.0e-6f;
+        static constexpr double DECAY_TIME_SECONDS = 0.25; // for the recursive filters (e.g. crossover and DC filter) to decay at 20 Hz
+
+        static inline bool isSilent( const float* channelData, int numSamples ) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax( channelData, numSamples );
+            return range.getStart() > -SILENCE_THRESHOLD && range.getEnd() < SILENCE_THRESHOLD;
+        }
+
+        // the amount of samples the output can be affected by past input : the latency of the split (in harmonic mode
+        // plus the length of the frame overlapping the last input) and the time for the recursive filters to decay
+        int getTailSamples( double sampleRate ) const {
+            const auto mode = splitMode.load();
+            const int frameSize = mode == Parameters::SplitMode::Harmonic ? 1 << getFFTOrder() : 0;
+
+            return getLatencyForMode( mode ) + frameSize + static_cast<int>( std::ceil( DECAY_TIME_SECONDS * sampleRate ));
+        }
         
-        // playback, tempo and time signature
+        // playback, tempo, time signature and song position (in quarter notes, negative when unknown)
 
         bool isPlaying = false;
         int timeSigNumerator = 4;
         int timeSigDenominator = 4;
         double tempo = 120.0;
+        double songPosition = -1.0;
         
         // parameters
 
         std::atomic<float>* linkEnabled;
         std::atomic<float>* splitFreq;
+        std::array<std::atomic<float>*, MAX_BANDS - 1> splitFreqs; // all splits, where the first equals splitFreq
+        std::atomic<float>* bandCount;
         std::atomic<Parameters::SplitMode> splitMode;
         std::atomic<float>* dryWetMix;
-        std::atomic<Parameters::DistortionType> loDistType;
-        std::atomic<float>* loDistInputLevel;
-        std::atomic<float>* loDistDrive;
-        std::atomic<float>* loDistParam;
-        std::atomic<Parameters::DistortionType> hiDistType;
-        std::atomic<float>* hiDistInputLevel;
-        std::atomic<float>* hiDistDrive;
-        std::atomic<float>* hiDistParam;
-        
-        inline void applyDistortion(
-            const int channel, float* loChannelData, float* hiChannelData,
-            const unsigned long loChannelSize, const unsigned long hiChannelSize
-        ) {
-            // distortions aren't stateful, when jointProcessing is true, we apply
-            // the settings of the low distortion onto the high channel
-
-            bool jointProcessing = ParameterUtilities::floatToBool( *linkEnabled );
-
-            switch ( loDistType )
-            {
-                case Parameters::DistortionType::Off:
-                    break;
-                
-                case Parameters::DistortionType::BitCrusher:
-                    loBitCrusher[ channel ].apply( loChannelData, loChannelSize );
-                    if ( jointProcessing ) {
-                        loBitCrusher[ channel ].apply( hiChannelData, hiChannelSize );
-                    }
-                    break;
-                
-                case Parameters::DistortionType::Fuzz:
-                    loFuzz.apply( loChannelData, loChannelSize );
-                    if ( jointProcessing ) {
-                        loFuzz.apply( hiChannelData, hiChannelSize );
-                    }
-                    break;
-
-                case Parameters::DistortionType::WaveFolder:
-                    loWaveFolder.apply( loChannelData, loChannelSize );
-                    if ( jointProcessing ) {
-                        loWaveFolder.apply( hiChannelData, hiChannelSize );
-                    }
-                    break;
+        std::atomic<float>* antiAliasing;
+        std::atomic<float>* fftSize;
+        std::atomic<float>* fftOverlap;
+        std::atomic<float>* oversampling;
+        std::atomic<float>* harmonicCount;
+        std::atomic<float>* harmonicWidth;
+        std::atomic<float>* harmonicFalloff;
+        std::array<std::atomic<float>*, Parameters::NUM_LFOS> lfoRates;
+        std::array<std::atomic<float>*, Parameters::NUM_LFOS> lfoShapes;
+        std::atomic<float>* envAttack;
+        std::atomic<float>* envRelease;
+
+        struct ModulationRoute
+        {
+            std::atomic<float>* source;
+            std::atomic<float>* target;
+            std::atomic<float>* depth;
+        };
+        std::array<ModulationRoute, Parameters::NUM_ROUTES> modulationRoutes;
 
-                case Parameters::DistortionType::WaveShaper:
-                    loWaveShaper.apply( loChannelData, loChannelSize );
-                    if ( jointProcessing ) {
-                        loWaveShaper.apply( hiChannelData, hiChannelSize );
-                    }
-                    break;
-            }
+        // the raw values of the choice parameters that are stored as enums above (the distortion types are stored per Band)
+        std::atomic<float>* splitModeValue;
+        
+        // distorts a band with the settings of provided slot (where the signal history is that of the slot within the channel)
 
-            if ( jointProcessing ) {
-                return; // hi channel processed above
-            }
+        inline void applyDistortion( ChannelContext& context, int slot, float* channelData, const unsigned long channelSize, const ParameterRamps* ramps )
+        {
+            auto& band = bands[ static_cast<size_t>( slot )];
+            const auto index = static_cast<size_t>( slot );
 
-            switch ( hiDistType )
+            switch ( band.type )
             {
                 case Parameters::DistortionType::Off:
                     break;
 
                 case Parameters::DistortionType::BitCrusher:
-                    hiBitCrusher[ channel ].apply( hiChannelData, hiChannelSize );
+                    context.bitCrushers[ index ].apply( channelData, channelSize, ramps );
                     break;
 
                 case Parameters::DistortionType::Fuzz:
-                    hiFuzz.apply( hiChannelData, hiChannelSize );
+                    band.fuzz.apply( channelData, channelSize, context.antiAliasing[ index ], ramps );
                     break;
 
                 case Parameters::DistortionType::WaveFolder:
-                    hiWaveFolder.apply( hiChannelData, hiChannelSize );
+                    band.waveFolder.apply( channelData, channelSize, context.antiAliasing[ index ], ramps );
                     break;
 
                 case Parameters::DistortionType::WaveShaper:
-                    hiWaveShaper.apply( hiChannelData, hiChannelSize );
+                    band.waveShaper.apply( channelData, channelSize, ramps );
                     break;
             }
         }
@@ -0,0 +1,778 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Benchmark.h"
+#include "../PluginProcessor.h"
+#include "../modules/bitcrusher/Bitcrusher.h"
+#include "../modules/crossover/Crossover.h"
+#include "../modules/dcfilter/DCFilter.h"
+#include "../modules/fft/FFT.h"
+#include "../modules/fuzz/Fuzz.h"
+#include "../modules/gain/AutoMakeUpGain.h"
+#include "../modules/modulation/ModulationMatrix.h"
+#include "../modules/oversampler/Oversampler.h"
+#include "../modules/smoother/SmootherBank.h"
+#include "../modules/wavefolder/Wavefolder.h"
+#include "../modules/waveshaper/Waveshaper.h"
+#include "../utils/MathUtilities.h"
+#include "../utils/ParameterUtilities.h"
+#include <iostream>
+
+/* constructor */
+
+Benchmark::Benchmark( const Settings& benchmarkSettings ) : settings( benchmarkSettings )
+{
+    // nowt...
+}
+
+/* public methods */
+
+void Benchmark::run()
+{
+    results.clear();
+    checks.clear();
+
+    runModules();
+    runFFT();
+    runProcessor();
+    runChannelLayouts();
+}
+
+bool Benchmark::hasPassed() const
+{
+    return std::all_of( checks.begin(), checks.end(), []( const Check& check ) { return check.passed(); });
+}
+
+juce::var Benchmark::toJSON() const
+{
+    juce::Array<juce::var> entries;
+
+    for ( const auto& result : results )
+    {
+        auto* entry = new juce::DynamicObject();
+
+        entry->setProperty( "benchmark",        result.name );
+        entry->setProperty( "variant",          result.variant );
+        entry->setProperty( "sampleRate",       result.sampleRate );
+        entry->setProperty( "blockSize",        result.blockSize );
+        entry->setProperty( "nsPerSample",      result.nsPerSample );
+        entry->setProperty( "worstBlockMicros", result.worstBlockMicros );
+        entry->setProperty( "deadlineUsage",    result.deadlineUsage );
+
+        entries.add( juce::var( entry ));
+    }
+
+    auto* root = new juce::DynamicObject();
+
+    root->setProperty( "plugin",  JucePlugin_Name );
+    root->setProperty( "os",      juce::SystemStats::getOperatingSystemName());
+    root->setProperty( "cpu",     juce::SystemStats::getCpuModel());
+    root->setProperty( "isa",     MathUtilities::getInstructionSet());
+    root->setProperty( "results", entries );
+
+    juce::Array<juce::var> checkEntries;
+
+    for ( const auto& check : checks )
+    {
+        auto* entry = new juce::DynamicObject();
+
+        entry->setProperty( "check",        check.name );
+        entry->setProperty( "maximumError", check.maximumError );
+        entry->setProperty( "tolerance",    check.tolerance );
+        entry->setProperty( "passed",       check.passed());
+
+        checkEntries.add( juce::var( entry ));
+    }
+    root->setProperty( "checks", checkEntries );
+
+    return juce::var( root );
+}
+
+/* private methods */
+
+void Benchmark::runModules()
+{
+    for ( const double sampleRate : getSampleRates())
+    {
+        for ( const int blockSize : getBlockSizes())
+        {
+            const juce::String variant;
+
+            // the memoryless shapers are measured both computing their curve directly and reading their
+            // transfer table (built synchronously before measuring so it is available from the first block onwards)
+
+            for ( const bool useTable : { false, true })
+            {
+                const juce::String tableVariant = useTable ? "table" : "direct";
+
+                if ( matchesFilter( "WaveShaper" )) {
+                    WaveShaper waveShaper;
+                    waveShaper.setLookupTableEnabled( useTable );
+                    waveShaper.setLookupTableSynchronous( true );
+                    waveShaper.updateLookupTable();
+                    add( "WaveShaper", tableVariant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                        [ &waveShaper ]( float* data, int size ) { waveShaper.apply( data, ( unsigned long ) size ); }
+                    ));
+                }
+
+                if ( matchesFilter( "WaveFolder" )) {
+                    WaveFolder waveFolder;
+                    waveFolder.setLookupTableEnabled( useTable );
+                    waveFolder.setLookupTableSynchronous( true );
+                    waveFolder.updateLookupTable();
+                    add( "WaveFolder", tableVariant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                        [ &waveFolder ]( float* data, int size ) { waveFolder.apply( data, ( unsigned long ) size ); }
+                    ));
+                }
+
+                if ( matchesFilter( "Fuzz" )) {
+                    Fuzz fuzz;
+                    fuzz.setLookupTableEnabled( useTable );
+                    fuzz.setLookupTableSynchronous( true );
+                    fuzz.updateLookupTable();
+                    add( "Fuzz", tableVariant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                        [ &fuzz ]( float* data, int size ) { fuzz.apply( data, ( unsigned long ) size ); }
+                    ));
+                }
+            }
+
+            // the shapers while their parameters are interpolating (computing their coefficients per sample)
+
+            std::vector<float> rampValues(( size_t ) blockSize, 0.5f );
+            const ParameterRamps ramps { rampValues.data(), rampValues.data(), rampValues.data() };
+
+            if ( matchesFilter( "WaveShaper" )) {
+                WaveShaper waveShaper;
+                add( "WaveShaper", "ramped", sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                    [ &waveShaper, &ramps ]( float* data, int size ) { waveShaper.apply( data, ( unsigned long ) size, &ramps ); }
+                ));
+            }
+
+            if ( matchesFilter( "WaveFolder" )) {
+                WaveFolder waveFolder;
+                AntiAliasing::State state;
+                add( "WaveFolder", "ramped", sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                    [ &waveFolder, &state, &ramps ]( float* data, int size ) { waveFolder.apply( data, ( unsigned long ) size, state, &ramps ); }
+                ));
+            }
+
+            if ( matchesFilter( "Fuzz" )) {
+                Fuzz fuzz;
+                AntiAliasing::State state;
+                add( "Fuzz", "ramped", sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                    [ &fuzz, &state, &ramps ]( float* data, int size ) { fuzz.apply( data, ( unsigned long ) size, state, &ramps ); }
+                ));
+            }
+
+            // anti-aliased variants of the shapers that support it
+
+            for ( const auto order : { AntiAliasing::Order::First, AntiAliasing::Order::Second })
+            {
+                const juce::String orderVariant = order == AntiAliasing::Order::First ? "adaa1" : "adaa2";
+                AntiAliasing::State state;
+
+                if ( matchesFilter( "WaveFolder" ) && order == AntiAliasing::Order::First ) {
+                    WaveFolder waveFolder;
+                    waveFolder.setAntiAliasing( order );
+                    add( "WaveFolder", orderVariant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                        [ &waveFolder, &state ]( float* data, int size ) { waveFolder.apply( data, ( unsigned long ) size, state ); }
+                    ));
+                }
+
+                if ( matchesFilter( "Fuzz" )) {
+                    Fuzz fuzz;
+                    fuzz.setAntiAliasing( order );
+                    add( "Fuzz", orderVariant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                        [ &fuzz, &state ]( float* data, int size ) { fuzz.apply( data, ( unsigned long ) size, state ); }
+                    ));
+                }
+            }
+
+            if ( matchesFilter( "BitCrusher" )) {
+                BitCrusher bitCrusher;
+                bitCrusher.prepare( blockSize );
+                add( "BitCrusher", variant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                    [ &bitCrusher ]( float* data, int size ) { bitCrusher.apply( data, ( unsigned long ) size ); }
+                ));
+            }
+
+            if ( matchesFilter( "SmootherBank" )) {
+                // all parameters interpolating during each block (the ramp duration exceeds the measurement)
+                SmootherBank smoothers;
+                smoothers.prepare( SmootherBank::MAX_PARAMETERS, sampleRate, 3600.f, blockSize );
+                for ( int index = 0; index < SmootherBank::MAX_PARAMETERS; ++index ) {
+                    smoothers.set( index, 1.f );
+                }
+                add( "SmootherBank", variant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                    [ &smoothers ]( float* data, int size ) { juce::ignoreUnused( data ); smoothers.process( size ); }
+                ));
+            }
+
+            // all sources in use (the envelope following the signal), rendering the per-sample values of two band targets
+
+            if ( matchesFilter( "ModulationMatrix" )) {
+                ModulationMatrix modulation;
+                modulation.prepare( sampleRate, blockSize );
+                modulation.setLFO( 0, ModulationMatrix::getBeatsPerCycle( 8, 4, 4 ), ModulationMatrix::Shape::Sine );
+                modulation.setLFO( 1, ModulationMatrix::getBeatsPerCycle( 2, 4, 4 ), ModulationMatrix::Shape::Triangle );
+                modulation.setRoute( 0, ModulationMatrix::Source::LFO1, ModulationMatrix::SplitFrequency, 0.5f );
+                modulation.setRoute( 1, ModulationMatrix::Source::LFO2, ModulationMatrix::getDriveTarget( 0 ), 0.5f );
+                modulation.setRoute( 2, ModulationMatrix::Source::Envelope, ModulationMatrix::getParamTarget( 0 ), 0.5f );
+
+                std::vector<float> base(( size_t ) blockSize, 0.5f );
+                std::vector<float> drive(( size_t ) blockSize );
+                std::vector<float> param(( size_t ) blockSize );
+
+                add( "ModulationMatrix", variant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                    [ &modulation, &base, &drive, &param ]( float* data, int size ) {
+                        const float* channels[] = { data };
+                        modulation.process( channels, 1, size, 120.0, -1.0, false );
+                        modulation.render( ModulationMatrix::getDriveTarget( 0 ), base.data(), drive.data(), 1.f, 0.f, 1.f );
+                        modulation.render( ModulationMatrix::getParamTarget( 0 ), base.data(), param.data(), 1.f, 0.f, 1.f );
+                    }
+                ));
+            }
+
+            // the filter processing the channels side by side, for both modes and a mono, stereo and 7.1 layout
+
+            if ( matchesFilter( "DCFilter" )) {
+                std::vector<float> channels(( size_t ) ( blockSize * 7 ));
+                for ( int channel = 0; channel < 7; ++channel ) {
+                    fillSignal( channels.data() + channel * blockSize, blockSize, sampleRate );
+                }
+
+                for ( const auto mode : { DCFilter::Mode::DCBlockAndLowPass, DCFilter::Mode::DCBlock }) {
+                    for ( const int numChannels : { 1, 2, 8 }) {
+                        DCFilter dcFilter;
+                        dcFilter.prepare( sampleRate, numChannels, blockSize );
+                        dcFilter.setMode( mode );
+
+                        const juce::String modeVariant = mode == DCFilter::Mode::DCBlock ? ", one-pole" : "";
+
+                        add( "DCFilter", juce::String( numChannels ) + " ch" + modeVariant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                            [ &dcFilter, &channels, numChannels ]( float* data, int size ) {
+                                std::array<float*, 8> output { data };
+
+                                for ( int channel = 1; channel < numChannels; ++channel ) {
+                                    output[ ( size_t ) channel ] = channels.data() + ( channel - 1 ) * size;
+                                }
+                                dcFilter.process( output.data(), numChannels, size );
+                            }
+                        ));
+                    }
+                }
+            }
+
+            if ( matchesFilter( "AutoMakeUpGain" )) {
+                AutoMakeUpGain makeup;
+                makeup.prepare( sampleRate, blockSize );
+                std::vector<float> pre(( size_t ) blockSize );
+                fillSignal( pre.data(), blockSize, sampleRate );
+                add( "AutoMakeUpGain", variant, sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                    [ &makeup, &pre ]( float* data, int size ) {
+                        makeup.analyse( pre.data(), size );
+                        makeup.apply( data, size );
+                    }
+                ));
+            }
+
+            // the crossover splitting both channels of a stereo signal into bands and summing them back
+            // together (including the phase compensation of the lower bands), for each amount of bands
+
+            if ( matchesFilter( "Crossover" )) {
+                std::vector<float> right(( size_t ) blockSize );
+                std::vector<float> bands(( size_t ) ( blockSize * Crossover::MAX_BANDS * 2 ));
+                fillSignal( right.data(), blockSize, sampleRate );
+
+                const float frequencies[] = {
+                    Parameters::Config::SPLIT_FREQ_DEF,   Parameters::Config::SPLIT_FREQ_2_DEF,
+                    Parameters::Config::SPLIT_FREQ_3_DEF, Parameters::Config::SPLIT_FREQ_4_DEF
+                };
+
+                for ( int numBands = 2; numBands <= Crossover::MAX_BANDS; ++numBands ) {
+                    Crossover crossover;
+                    crossover.prepare( sampleRate, 2, blockSize );
+                    crossover.setNumBands( numBands );
+
+                    for ( int split = 0; split < Crossover::MAX_SPLITS; ++split ) {
+                        crossover.setCutoffFrequency( split, frequencies[ split ]);
+                    }
+
+                    add( "Crossover", "stereo, " + juce::String( numBands ) + " bands", sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                        [ &crossover, &right, &bands, numBands ]( float* data, int size ) {
+                            const float* input[] = { data, right.data() };
+                            std::array<float*, Crossover::MAX_BANDS * 2> output;
+
+                            for ( size_t i = 0; i < output.size(); ++i ) {
+                                output[ i ] = bands.data() + i * ( size_t ) size;
+                            }
+                            crossover.process( input, output.data(), 2, size );
+
+                            for ( int channel = 0; channel < 2; ++channel ) {
+                                float* sum = output[ ( size_t ) ( channel * Crossover::MAX_BANDS )];
+
+                                for ( int band = 1; band < numBands; ++band ) {
+                                    if ( band < numBands - 1 ) {
+                                        crossover.compensate( channel, band, sum, size );
+                                    }
+                                    const float* bandData = output[ ( size_t ) ( channel * Crossover::MAX_BANDS + band )];
+
+                                    for ( int i = 0; i < size; ++i ) {
+                                        sum[ i ] += bandData[ i ];
+                                    }
+                                }
+                            }
+                        }
+                    ));
+                }
+            }
+
+            // the round trip (up- and downsampling both bands) of each oversampling factor, e.g. the
+            // overhead oversampling adds to the band distortion (excluding the cost of distorting more samples)
+
+            if ( matchesFilter( "Oversampler" )) {
+                Oversampler::Buffers buffers;
+                buffers.prepare( blockSize );
+                std::vector<float> hi(( size_t ) blockSize );
+                fillSignal( hi.data(), blockSize, sampleRate );
+
+                for ( int order = 1; order <= Oversampler::MAX_ORDER; ++order ) {
+                    Oversampler oversampler;
+                    oversampler.setOrder( order );
+                    add( "Oversampler", ParameterUtilities::getOversamplingNames()[ order ], sampleRate, blockSize, measureModule( sampleRate, blockSize,
+                        [ &oversampler, &buffers, &hi ]( float* data, int size ) {
+                            const size_t index = oversampler.upsample( data, hi.data(), size, buffers );
+                            oversampler.downsample( buffers, index, data, hi.data(), size );
+                        }
+                    ));
+                }
+            }
+        }
+    }
+}
+
+void Benchmark::runFFT()
+{
+    if ( !matchesFilter( "FFT" )) {
+        return;
+    }
+
+    // the FFT operates on fixed size frames (once every hop), its cost is thus independent of the
+    // host block size, measurements are expressed per hop (e.g. blockSize equals the hop size)
+
+    std::vector<float> inputBuffer( Parameters::FFT::MAX_SIZE );
+    std::vector<float> outputBuffer( Parameters::FFT::MAX_SIZE, 0.f );
+    std::vector<float> specA( Parameters::FFT::MAX_DOUBLE_SIZE, 0.f );
+    std::vector<float> specB( Parameters::FFT::MAX_DOUBLE_SIZE, 0.f );
+    std::vector<float> referenceA( Parameters::FFT::MAX_DOUBLE_SIZE, 0.f );
+    std::vector<float> referenceB( Parameters::FFT::MAX_DOUBLE_SIZE, 0.f );
+
+    for ( const double sampleRate : getSampleRates())
+    {
+        FFT fft;
+        fft.setSynchronous( true ); // masks are built on update(), outside of the timed region
+        fft.prepare( sampleRate );
+
+        for ( int order = Parameters::FFT::MIN_ORDER; order <= Parameters::FFT::MAX_ORDER; ++order )
+        {
+            // the overlap doesn't affect the cost per frame, only the amount of frames per second
+
+            for ( const int overlap : { 2, 4 })
+            {
+                fft.configure( order, overlap );
+                fft.setHarmonics(
+                    Parameters::Config::SPLIT_FREQ_DEF, Parameters::Config::HARMONIC_COUNT_DEF,
+                    Parameters::Config::HARMONIC_WIDTH_DEF, Parameters::Config::HARMONIC_FALLOFF_DEF
+                );
+                fft.update();
+
+                const int size    = fft.getSize();
+                const int hopSize = fft.getHopSize();
+                const juce::String variant = juce::String( size ) + " / " + juce::String( overlap ) + "x";
+
+                fillSignal( inputBuffer.data(), size, sampleRate );
+
+                // verify the packed (single inverse) split matches the reference split that
+                // inverts both spectra separately (the ring offset is arbitrary, to test unwrapping)
+
+                if ( overlap == 2 ) {
+                    const auto offset = static_cast<size_t>( size / 3 );
+
+                    fft.split( inputBuffer.data(), offset, specA, specB );
+                    fft.splitSeparate( inputBuffer.data(), offset, referenceA, referenceB );
+
+                    double maximumError = 0.0;
+                    for ( size_t i = 0; i < static_cast<size_t>( size ); ++i ) {
+                        maximumError = std::max( maximumError, ( double ) std::abs( specA[ i ] - referenceA[ i ]));
+                        maximumError = std::max( maximumError, ( double ) std::abs( specB[ i ] - referenceB[ i ]));
+                    }
+                    addCheck( "FFT::split equals FFT::splitSeparate (" + juce::String( size ) + " @ " + juce::String( sampleRate, 0 ) + " Hz)",
+                              maximumError, SPLIT_TOLERANCE );
+                }
+
+                add( "FFT::split", variant, sampleRate, hopSize, measure( sampleRate, hopSize, [ & ] {
+                    fft.split( inputBuffer.data(), 0, specA, specB );
+                }));
+
+                add( "FFT::split", variant + " separate inverse", sampleRate, hopSize, measure( sampleRate, hopSize, [ & ] {
+                    fft.splitSeparate( inputBuffer.data(), 0, specA, specB );
+                }));
+
+                add( "FFT::sum", variant, sampleRate, hopSize, measure( sampleRate, hopSize, [ & ] {
+                    std::fill( outputBuffer.begin(), outputBuffer.end(), 0.f );
+                    fft.sum( outputBuffer.data(), 0, specA, specB );
+                }));
+            }
+        }
+    }
+}
+
+void Benchmark::runProcessor()
+{
+    const auto splitModes      = ParameterUtilities::getSplitModeNames();
+    const auto distortionTypes = ParameterUtilities::getDistortionTypeNames();
+
+    for ( int mode = 0; mode < splitModes.size(); ++mode )
+    {
+        const juce::String name = "processBlock (" + splitModes[ mode ] + ")";
+
+        if ( !matchesFilter( name )) {
+            continue;
+        }
+
+        for ( int loType = 0; loType < distortionTypes.size(); ++loType )
+        {
+            for ( int hiType = 0; hiType < distortionTypes.size(); ++hiType )
+            {
+                const juce::String variant = distortionTypes[ loType ] + " / " + distortionTypes[ hiType ];
+
+                for ( const double sampleRate : getSampleRates())
+                {
+                    for ( const int blockSize : getBlockSizes())
+                    {
+                        AudioPluginAudioProcessor processor;
+
+                        setParameter( processor, Parameters::SPLIT_MODE,   static_cast<float>( mode ));
+                        setParameter( processor, Parameters::LO_DIST_TYPE, static_cast<float>( loType ));
+                        setParameter( processor, Parameters::HI_DIST_TYPE, static_cast<float>( hiType ));
+
+                        processor.setNonRealtime( false );
+                        processor.setRateAndBufferSizeDetails( sampleRate, blockSize );
+                        processor.prepareToPlay( sampleRate, blockSize );
+
+                        const int numChannels = processor.getTotalNumOutputChannels();
+
+                        juce::AudioBuffer<float> signal( numChannels, blockSize );
+                        juce::AudioBuffer<float> buffer( numChannels, blockSize );
+                        juce::MidiBuffer midiBuffer;
+
+                        for ( int channel = 0; channel < numChannels; ++channel ) {
+                            fillSignal( signal.getWritePointer( channel ), blockSize, sampleRate );
+                        }
+
+                        add( name, variant, sampleRate, blockSize, measure( sampleRate, blockSize, [ & ] {
+                            processor.processBlock( buffer, midiBuffer );
+                        }, [ & ] {
+                            for ( int channel = 0; channel < numChannels; ++channel ) {
+                                buffer.copyFrom( channel, 0, signal, channel, 0, blockSize );
+                            }
+                        }));
+
+                        processor.releaseResources();
+                    }
+                }
+            }
+        }
+
+        // silent input, where the channels are idle once the tail has been flushed
+
+        for ( const double sampleRate : getSampleRates())
+        {
+            for ( const int blockSize : getBlockSizes())
+            {
+                AudioPluginAudioProcessor processor;
+
+                setParameter( processor, Parameters::SPLIT_MODE, static_cast<float>( mode ));
+
+                processor.setNonRealtime( false );
+                processor.setRateAndBufferSizeDetails( sampleRate, blockSize );
+                processor.prepareToPlay( sampleRate, blockSize );
+
+                juce::AudioBuffer<float> buffer( processor.getTotalNumOutputChannels(), blockSize );
+                juce::MidiBuffer midiBuffer;
+
+                const int tailBlocks = static_cast<int>( std::ceil( processor.getTailLengthSeconds() * sampleRate / blockSize )) + 1;
+
+                for ( int i = 0; i < tailBlocks; ++i ) {
+                    buffer.clear();
+                    processor.processBlock( buffer, midiBuffer );
+                }
+
+                add( name, "silence", sampleRate, blockSize, measure( sampleRate, blockSize, [ & ] {
+                    processor.processBlock( buffer, midiBuffer );
+                }, [ & ] {
+                    buffer.clear();
+                }));
+
+                processor.releaseResources();
+            }
+        }
+
+        // continuously modulated split frequencies and drive (a sixteenth note LFO), where the crossover
+        // coefficients or harmonic mask follow the modulation and the shapers compute their curve directly
+
+        for ( const double sampleRate : getSampleRates())
+        {
+            for ( const int blockSize : getBlockSizes())
+            {
+                AudioPluginAudioProcessor processor;
+
+                setParameter( processor, Parameters::SPLIT_MODE,   static_cast<float>( mode ));
+                setParameter( processor, Parameters::LO_DIST_TYPE, 1.f );
+                setParameter( processor, Parameters::HI_DIST_TYPE, 1.f );
+                setParameter( processor, Parameters::LFO1_RATE,    8.f );
+                setParameter( processor, Parameters::MOD1_SOURCE,  1.f );
+                setParameter( processor, Parameters::MOD1_TARGET,  static_cast<float>( ModulationMatrix::SplitFrequency ));
+                setParameter( processor, Parameters::MOD1_DEPTH,   0.5f );
+                setParameter( processor, Parameters::MOD2_SOURCE,  1.f );
+                setParameter( processor, Parameters::MOD2_TARGET,  static_cast<float>( ModulationMatrix::getDriveTarget( 0 )));
+                setParameter( processor, Parameters::MOD2_DEPTH,   0.5f );
+
+                processor.setNonRealtime( false );
+                processor.setRateAndBufferSizeDetails( sampleRate, blockSize );
+                processor.prepareToPlay( sampleRate, blockSize );
+
+                const int numChannels = processor.getTotalNumOutputChannels();
+
+                juce::AudioBuffer<float> signal( numChannels, blockSize );
+                juce::AudioBuffer<float> buffer( numChannels, blockSize );
+                juce::MidiBuffer midiBuffer;
+
+                for ( int channel = 0; channel < numChannels; ++channel ) {
+                    fillSignal( signal.getWritePointer( channel ), blockSize, sampleRate );
+                }
+
+                add( name, "modulated", sampleRate, blockSize, measure( sampleRate, blockSize, [ & ] {
+                    processor.processBlock( buffer, midiBuffer );
+                }, [ & ] {
+                    for ( int channel = 0; channel < numChannels; ++channel ) {
+                        buffer.copyFrom( channel, 0, signal, channel, 0, blockSize );
+                    }
+                }));
+
+                processor.releaseResources();
+            }
+        }
+    }
+}
+
+void Benchmark::runChannelLayouts()
+{
+    // processing cost should scale linearly with the amount of channels, measured using the default distortion types
+    // both serially and with parallel processing enabled (which only engages when the work per block is large enough)
+
+    const auto splitModes = ParameterUtilities::getSplitModeNames();
+    const std::vector<juce::AudioChannelSet> layouts = {
+        juce::AudioChannelSet::mono(),
+        juce::AudioChannelSet::stereo(),
+        juce::AudioChannelSet::create5point1(),
+        juce::AudioChannelSet::create7point1point4(),
+        juce::AudioChannelSet::discreteChannels( 16 )
+    };
+    const double sampleRate = 48000.0;
+    const int blockSize     = 2048; // large enough for parallel processing to engage on the larger layouts
+
+    for ( int mode = 0; mode < splitModes.size(); ++mode )
+    {
+        const juce::String name = "processBlock layout (" + splitModes[ mode ] + ")";
+
+        if ( !matchesFilter( name )) {
+            continue;
+        }
+
+        for ( const auto& channelSet : layouts )
+        {
+            for ( const bool parallel : { false, true })
+            {
+                AudioPluginAudioProcessor processor;
+                processor.setParallelProcessing( parallel );
+
+                juce::AudioProcessor::BusesLayout layout;
+                layout.inputBuses.add( channelSet );
+                layout.outputBuses.add( channelSet );
+
+                if ( !processor.setBusesLayout( layout )) {
+                    continue;
+                }
+                setParameter( processor, Parameters::SPLIT_MODE, static_cast<float>( mode ));
+
+                processor.setNonRealtime( false );
+                processor.setRateAndBufferSizeDetails( sampleRate, blockSize );
+                processor.prepareToPlay( sampleRate, blockSize );
+
+                const int numChannels = channelSet.size();
+                const juce::String variant = channelSet.getDescription() + " (" + juce::String( numChannels ) + " channels, " +
+                                             ( parallel ? "parallel" : "serial" ) + ")";
+
+                juce::AudioBuffer<float> signal( numChannels, blockSize );
+                juce::AudioBuffer<float> buffer( numChannels, blockSize );
+                juce::MidiBuffer midiBuffer;
+
+                for ( int channel = 0; channel < numChannels; ++channel ) {
+                    fillSignal( signal.getWritePointer( channel ), blockSize, sampleRate );
+                }
+
+                add( name, variant, sampleRate, blockSize, measure( sampleRate, blockSize, [ & ] {
+                    processor.processBlock( buffer, midiBuffer );
+                }, [ & ] {
+                    for ( int channel = 0; channel < numChannels; ++channel ) {
+                        buffer.copyFrom( channel, 0, signal, channel, 0, blockSize );
+                    }
+                }));
+
+                processor.releaseResources();
+            }
+        }
+    }
+}
+
+Benchmark::Measurement Benchmark::measureModule( double sampleRate, int blockSize, const std::function<void( float*, int )>& process )
+{
+    std::vector<float> signal(( size_t ) blockSize );
+    std::vector<float> buffer(( size_t ) blockSize );
+
+    fillSignal( signal.data(), blockSize, sampleRate );
+
+    return measure( sampleRate, blockSize, [ & ] {
+        process( buffer.data(), blockSize );
+    }, [ & ] {
+        std::copy( signal.begin(), signal.end(), buffer.begin());
+    });
+}
+
+Benchmark::Measurement Benchmark::measure( double sampleRate, int blockSize, const std::function<void()>& process, const std::function<void()>& prepare )
+{
+    const auto totalSamples = static_cast<juce::int64>( sampleRate * settings.durationInSeconds );
+    const int  numBlocks    = juce::jmax( MIN_BLOCKS, static_cast<int>( totalSamples / blockSize ));
+
+    // warm up caches, smoothers and lazily computed state
+
+    for ( int i = 0; i < WARMUP_BLOCKS; ++i ) {
+        if ( prepare ) prepare();
+        process();
+    }
+
+    juce::int64 totalTicks = 0;
+    juce::int64 worstTicks = 0;
+
+    for ( int i = 0; i < numBlocks; ++i )
+    {
+        if ( prepare ) prepare();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        process();
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        totalTicks += elapsed;
+        worstTicks  = std::max( worstTicks, elapsed );
+    }
+
+    const double totalSeconds = juce::Time::highResolutionTicksToSeconds( totalTicks );
+    const double worstSeconds = juce::Time::highResolutionTicksToSeconds( worstTicks );
+    const double deadline     = static_cast<double>( blockSize ) / sampleRate;
+
+    Measurement measurement;
+
+    measurement.nsPerSample      = totalSeconds * 1e9 / ( static_cast<double>( numBlocks ) * blockSize );
+    measurement.worstBlockMicros = worstSeconds * 1e6;
+    measurement.deadlineUsage    = worstSeconds / deadline;
+
+    return measurement;
+}
+
+void Benchmark::add( const juce::String& name, const juce::String& variant, double sampleRate, int blockSize, Measurement measurement )
+{
+    measurement.name       = name;
+    measurement.variant    = variant;
+    measurement.sampleRate = sampleRate;
+    measurement.blockSize  = blockSize;
+
+    if ( settings.verbose ) {
+        std::cout << name.paddedRight( ' ', 28 ) << variant.paddedRight( ' ', 28 )
+                  << juce::String( sampleRate, 0 ).paddedLeft( ' ', 7 ) << " Hz"
+                  << juce::String( blockSize ).paddedLeft( ' ', 6 ) << " samples"
+                  << juce::String( measurement.nsPerSample, 2 ).paddedLeft( ' ', 10 ) << " ns/sample"
+                  << juce::String( measurement.worstBlockMicros, 1 ).paddedLeft( ' ', 10 ) << " us worst"
+                  << juce::String( measurement.deadlineUsage * 100.0, 2 ).paddedLeft( ' ', 8 ) << " % of deadline"
+                  << std::endl;
+    }
+    results.push_back( measurement );
+}
+
+void Benchmark::addCheck( const juce::String& name, double maximumError, double tolerance )
+{
+    Check check { name, maximumError, tolerance };
+
+    if ( settings.verbose || !check.passed()) {
+        std::cout << ( check.passed() ? "PASS " : "FAIL " ) << name.paddedRight( ' ', 51 )
+                  << " maximum error " << maximumError << " (tolerance " << tolerance << ")" << std::endl;
+    }
+    checks.push_back( check );
+}
+
+std::vector<int> Benchmark::getBlockSizes() const
+{
+    if ( settings.quick ) {
+        return { 64, 512, 4096 };
+    }
+    return { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+}
+
+std::vector<double> Benchmark::getSampleRates() const
+{
+    if ( settings.quick ) {
+        return { 44100.0, 96000.0, 192000.0 };
+    }
+    return { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+}
+
+bool Benchmark::matchesFilter( const juce::String& name ) const
+{
+    return settings.filter.isEmpty() || name.containsIgnoreCase( settings.filter );
+}
+
+void Benchmark::fillSignal( float* data, int size, double sampleRate )
+{
+    // a mix of a low and high sine with some noise, peaking around -3 dB
+    // a fixed seed keeps the input identical between runs
+
+    juce::Random random( 1337 );
+    const double twoPi = juce::MathConstants<double>::twoPi;
+
+    for ( int i = 0; i < size; ++i ) {
+        const double t = static_cast<double>( i ) / sampleRate;
+
+        data[ i ] = static_cast<float>(
+            0.4 * std::sin( twoPi * 110.0 * t ) + 0.2 * std::sin( twoPi * 2750.0 * t ) + 0.1 * ( random.nextDouble() * 2.0 - 1.0 )
+        );
+    }
+}
+
+void Benchmark::setParameter( AudioPluginAudioProcessor& processor, const juce::String& id, float value )
+{
+    auto* parameter = processor.parameters.getParameter( id );
+    parameter->setValueNotifyingHost( parameter->convertTo0to1( value )); // applied by the next prepareToPlay() or processBlock() call
+}
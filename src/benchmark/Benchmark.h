@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+class AudioPluginAudioProcessor;
+
+/**
+ * Measures the processing cost of the individual DSP modules and of the full
+ * AudioPluginAudioProcessor::processBlock() across a range of block sizes, sample rates,
+ * split modes and distortion types. Results can be exported as JSON to allow comparing
+ * against stored baselines between releases.
+ */
+class Benchmark
+{
+    static constexpr int WARMUP_BLOCKS = 8;
+    static constexpr int MIN_BLOCKS    = 32;
+
+    // maximum deviation of the packed FFT split from its reference, for a full scale input signal
+    static constexpr double SPLIT_TOLERANCE = 1e-4;
+
+    public:
+        struct Settings
+        {
+            double durationInSeconds = 0.5; // amount of audio to process per measurement
+            juce::String filter;            // when not empty, only run benchmarks whose name contains this value
+            bool quick   = false;           // when true, only a subset of block sizes and sample rates is measured
+            bool verbose = true;            // when true, results are logged to stdout as they come in
+        };
+
+        struct Measurement
+        {
+            juce::String name;
+            juce::String variant;
+            double sampleRate = 0.0;
+            int blockSize = 0;
+            double nsPerSample = 0.0;      // average processing time per sample
+            double worstBlockMicros = 0.0; // processing time of the slowest block
+            double deadlineUsage = 0.0;    // slowest block time relative to the block duration (1.0 == realtime deadline)
+        };
+
+        // a comparison between an optimized code path and its reference implementation
+        struct Check
+        {
+            juce::String name;
+            double maximumError = 0.0; // largest absolute difference between both outputs
+            double tolerance    = 0.0;
+
+            bool passed() const { return maximumError <= tolerance; }
+        };
+
+        explicit Benchmark( const Settings& settings );
+
+        void run();
+        juce::var toJSON() const;
+
+        const std::vector<Measurement>& getResults() const { return results; }
+        const std::vector<Check>& getChecks() const { return checks; }
+
+        // whether all checks performed during run() passed
+        bool hasPassed() const;
+
+    private:
+        Settings settings;
+        std::vector<Measurement> results;
+        std::vector<Check> checks;
+
+        void runModules();
+        void runFFT();
+        void runProcessor();
+        void runChannelLayouts();
+
+        Measurement measureModule( double sampleRate, int blockSize, const std::function<void( float*, int )>& process );
+        Measurement measure( double sampleRate, int blockSize, const std::function<void()>& process, const std::function<void()>& prepare = nullptr );
+        void add( const juce::String& name, const juce::String& variant, double sampleRate, int blockSize, Measurement measurement );
+        void addCheck( const juce::String& name, double maximumError, double tolerance );
+
+        std::vector<int> getBlockSizes() const;
+        std::vector<double> getSampleRates() const;
+        bool matchesFilter( const juce::String& name ) const;
+
+        static void fillSignal( float* data, int size, double sampleRate );
+        static void setParameter( AudioPluginAudioProcessor& processor, const juce::String& id, float value );
+};
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <juce_events/juce_events.h>
+#include "Benchmark.h"
+#include <iostream>
+
+static void printUsage()
+{
+    std::cout << "Usage: phlegetron_benchmark [options]" << std::endl << std::endl
+              << "Options:" << std::endl
+              << "  --json <file>         write the results as JSON to provided file" << std::endl
+              << "  --filter <name>       only run benchmarks whose name contains provided value (e.g. \"WaveFolder\")" << std::endl
+              << "  --duration <seconds>  amount of audio to process per measurement (defaults to 0.5)" << std::endl
+              << "  --quick               measure a reduced set of block sizes and sample rates" << std::endl
+              << "  --silent              don't log individual results to stdout" << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    Benchmark::Settings settings;
+    juce::File jsonFile;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        const juce::String argument( argv[ i ]);
+        const bool hasValue = i + 1 < argc;
+
+        if ( argument == "--json" && hasValue ) {
+            jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile( argv[ ++i ]);
+        } else if ( argument == "--filter" && hasValue ) {
+            settings.filter = argv[ ++i ];
+        } else if ( argument == "--duration" && hasValue ) {
+            settings.durationInSeconds = juce::jmax( 0.01, juce::String( argv[ ++i ]).getDoubleValue());
+        } else if ( argument == "--quick" ) {
+            settings.quick = true;
+        } else if ( argument == "--silent" ) {
+            settings.verbose = false;
+        } else {
+            printUsage();
+            return argument == "--help" || argument == "-h" ? 0 : 1;
+        }
+    }
+
+    Benchmark benchmark( settings );
+    benchmark.run();
+
+    if ( jsonFile != juce::File()) {
+        if ( !jsonFile.replaceWithText( juce::JSON::toString( benchmark.toJSON()))) {
+            std::cerr << "Could not write results to " << jsonFile.getFullPathName() << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << benchmark.getResults().size() << " result(s) to " << jsonFile.getFullPathName() << std::endl;
+    }
+    if ( !benchmark.hasPassed()) {
+        std::cerr << "One or more checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
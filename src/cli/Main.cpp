@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <juce_events/juce_events.h>
+#include "OfflineRenderer.h"
+#include <iostream>
+
+static void printUsage()
+{
+    std::cout << "Usage: phlegetron_render [options] <file|directory> [<file|directory> ...]" << std::endl << std::endl
+              << "Renders WAV/AIFF files through Phlegetron, writing the result to the output directory." << std::endl << std::endl
+              << "Options:" << std::endl
+              << "  --output <directory>  output directory (defaults to ./rendered)" << std::endl
+              << "  --preset <file>       parameter state to apply, either the binary state as saved by" << std::endl
+              << "                        the plugin or its XML representation" << std::endl
+              << "  --block-size <n>      processing block size in samples (defaults to 512)" << std::endl
+              << "  --threads <n>         amount of worker threads (defaults to the amount of CPU cores)" << std::endl
+              << "  --seed <n>            seed for the random generators (defaults to 0), renders using the" << std::endl
+              << "                        same seed, preset and input are identical" << std::endl;
+}
+
+/**
+ * Reads the processor state from file. Both the binary ValueTree format written by
+ * AudioProcessor::getStateInformation() and its XML representation are supported.
+ */
+static bool readState( const juce::File& file, juce::MemoryBlock& destData )
+{
+    juce::ValueTree tree;
+
+    if ( file.hasFileExtension( "xml" )) {
+        if ( auto xml = juce::XmlDocument::parse( file )) {
+            tree = juce::ValueTree::fromXml( *xml );
+        }
+    } else {
+        juce::MemoryBlock data;
+        if ( file.loadFileAsData( data )) {
+            tree = juce::ValueTree::readFromData( data.getData(), data.getSize());
+        }
+    }
+
+    if ( !tree.isValid()) {
+        return false;
+    }
+    juce::MemoryOutputStream stream( destData, false );
+    tree.writeToStream( stream );
+
+    return true;
+}
+
+int main( int argc, char* argv[] )
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    OfflineRenderer::Settings settings;
+    settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile( "rendered" );
+
+    juce::Array<juce::File> files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        const juce::String argument( argv[ i ]);
+        const bool hasValue = i + 1 < argc;
+
+        if ( argument == "--help" || argument == "-h" ) {
+            printUsage();
+            return 0;
+        }
+
+        if ( argument == "--output" && hasValue ) {
+            settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile( argv[ ++i ]);
+        } else if ( argument == "--preset" && hasValue ) {
+            auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile( argv[ ++i ]);
+            if ( !readState( presetFile, settings.state )) {
+                std::cerr << "Could not read preset " << presetFile.getFullPathName() << std::endl;
+                return 1;
+            }
+        } else if ( argument == "--block-size" && hasValue ) {
+            settings.blockSize = juce::String( argv[ ++i ]).getIntValue();
+        } else if ( argument == "--threads" && hasValue ) {
+            settings.numThreads = juce::String( argv[ ++i ]).getIntValue();
+        } else if ( argument == "--seed" && hasValue ) {
+            settings.seed = ( juce::uint32 ) juce::String( argv[ ++i ]).getLargeIntValue();
+        } else if ( argument.startsWith( "--" )) {
+            std::cerr << "Unknown or incomplete option " << argument << std::endl;
+            printUsage();
+            return 1;
+        } else {
+            auto path = juce::File::getCurrentWorkingDirectory().getChildFile( argument );
+
+            if ( path.isDirectory()) {
+                for ( const auto& child : path.findChildFiles( juce::File::findFiles, false )) {
+                    if ( OfflineRenderer::isSupportedFile( child )) {
+                        files.addIfNotAlreadyThere( child );
+                    }
+                }
+            } else if ( path.existsAsFile()) {
+                files.addIfNotAlreadyThere( path );
+            } else {
+                std::cerr << "No such file or directory " << path.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    if ( files.isEmpty()) {
+        printUsage();
+        return 1;
+    }
+
+    OfflineRenderer renderer( settings );
+
+    // the output files are named after the input files, inputs from different directories that share
+    // a file name would be rendered onto the same output file (by concurrent workers) and are rejected
+
+    for ( int i = 1; i < files.size(); ++i ) {
+        const auto outputFile = renderer.getOutputFile( files[ i ]);
+
+        for ( int j = 0; j < i; ++j ) {
+            if ( renderer.getOutputFile( files[ j ]) == outputFile ) {
+                std::cerr << "Both " << files[ j ].getFullPathName() << " and " << files[ i ].getFullPathName()
+                          << " would be rendered to " << outputFile.getFullPathName()
+                          << ", render these in separate runs (using different output directories)" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return renderer.render( files ) == 0 ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "OfflineRenderer.h"
+#include "../PluginProcessor.h"
+#include <iostream>
+
+/**
+ * A worker owns a single processor instance for its entire lifetime, processors
+ * are thus never shared between threads. Files are picked from the renderers
+ * queue until it has been exhausted.
+ */
+class OfflineRenderer::Worker : public juce::Thread
+{
+    public:
+        Worker( OfflineRenderer& owner, int index ) : juce::Thread( "Render worker " + juce::String( index )),
+            renderer( owner ),
+            processor( std::make_unique<AudioPluginAudioProcessor>())
+        {
+            // nowt...
+        }
+
+        void run() override
+        {
+            while ( !threadShouldExit())
+            {
+                const int index = renderer.nextFileIndex.fetch_add( 1 );
+
+                if ( index >= renderer.queue->size()) {
+                    break;
+                }
+                renderer.report( renderer.renderFile( *processor, renderer.queue->getReference( index )));
+            }
+        }
+
+    private:
+        OfflineRenderer& renderer;
+        std::unique_ptr<AudioPluginAudioProcessor> processor;
+};
+
+/* constructor */
+
+OfflineRenderer::OfflineRenderer( const Settings& renderSettings ) : settings( renderSettings )
+{
+    formatManager.registerBasicFormats();
+
+    settings.blockSize = juce::jmax( 1, settings.blockSize );
+
+    if ( settings.numThreads <= 0 ) {
+        settings.numThreads = juce::SystemStats::getNumCpus();
+    }
+}
+
+/* public methods */
+
+int OfflineRenderer::render( const juce::Array<juce::File>& files )
+{
+    if ( files.isEmpty()) {
+        return 0;
+    }
+
+    if ( !settings.outputDirectory.createDirectory()) {
+        std::cerr << "Could not create output directory " << settings.outputDirectory.getFullPathName() << std::endl;
+        return files.size();
+    }
+
+    queue = &files;
+    nextFileIndex = 0;
+    failures = 0;
+
+    const int numWorkers = juce::jmin( settings.numThreads, files.size());
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    // processors are instantiated on the calling thread, rendering happens on the workers
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    for ( int i = 0; i < numWorkers; ++i ) {
+        workers.push_back( std::make_unique<Worker>( *this, i ));
+    }
+
+    for ( auto& worker : workers ) {
+        worker->startThread();
+    }
+
+    for ( auto& worker : workers ) {
+        worker->waitForThreadToExit( -1 );
+    }
+
+    const double elapsed = ( juce::Time::getMillisecondCounterHiRes() - startTime ) / 1000.0;
+
+    std::cout << "Rendered " << ( files.size() - failures.load()) << " of " << files.size() << " file(s) using "
+              << numWorkers << " thread(s) in " << juce::String( elapsed, 2 ) << " s" << std::endl;
+
+    queue = nullptr;
+
+    return failures.load();
+}
+
+juce::File OfflineRenderer::getOutputFile( const juce::File& file ) const
+{
+    return settings.outputDirectory.getChildFile( file.getFileName());
+}
+
+bool OfflineRenderer::isSupportedFile( const juce::File& file )
+{
+    return file.hasFileExtension( "wav;aif;aiff" );
+}
+
+/* private methods */
+
+OfflineRenderer::Result OfflineRenderer::renderFile( juce::AudioProcessor& processor, const juce::File& file )
+{
+    Result result;
+    result.file = file;
+
+    std::unique_ptr<juce::AudioFormatReader> reader( formatManager.createReaderFor( file ));
+
+    if ( reader == nullptr ) {
+        result.error = "unsupported or unreadable file";
+        return result;
+    }
+
+    const int numChannels   = static_cast<int>( reader->numChannels );
+    const double sampleRate = reader->sampleRate;
+    const int blockSize     = settings.blockSize;
+    const juce::int64 totalSamples = reader->lengthInSamples;
+
+    // match the processors bus layout to the file (twelve channel files are assumed to be 7.1.4, as
+    // the canonical layout for that amount is discrete, which the processor supports equally)
+
+    auto channelSet = numChannels == 12 ? juce::AudioChannelSet::create7point1point4()
+                                        : juce::AudioChannelSet::canonicalChannelSet( numChannels );
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add( channelSet );
+    layout.outputBuses.add( channelSet );
+
+    if ( channelSet.isDisabled() || !processor.setBusesLayout( layout )) {
+        result.error = "unsupported channel layout (" + juce::String( numChannels ) + " channels)";
+        return result;
+    }
+
+    // prepare the output file using the same format as the input
+
+    auto* format = formatManager.findFormatForFileExtension( file.getFileExtension());
+    auto outputFile = getOutputFile( file );
+
+    if ( outputFile == file ) {
+        result.error = "output would overwrite input file";
+        return result;
+    }
+    outputFile.deleteFile();
+
+    std::unique_ptr<juce::OutputStream> outputStream = outputFile.createOutputStream();
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    if ( format != nullptr && outputStream != nullptr ) {
+        writer = format->createWriterFor(
+            outputStream,
+            juce::AudioFormatWriterOptions{}
+                .withSampleRate( sampleRate )
+                .withNumChannels( numChannels )
+                .withBitsPerSample( static_cast<int>( reader->bitsPerSample ))
+        );
+    }
+
+    if ( writer == nullptr ) {
+        result.error = "could not create output file " + outputFile.getFullPathName();
+        return result;
+    }
+
+    // prepare the processor
+
+    processor.setNonRealtime( true );
+    processor.setRateAndBufferSizeDetails( sampleRate, blockSize );
+    processor.setRandomSeed( settings.seed );
+
+    if ( settings.state.getSize() > 0 ) {
+        processor.setStateInformation( settings.state.getData(), static_cast<int>( settings.state.getSize()));
+    }
+    processor.prepareToPlay( sampleRate, blockSize );
+
+    // render, note that reading beyond the end of the input yields silence, which is
+    // used to flush the processors latency (the first latency samples are omitted from the output)
+
+    juce::AudioBuffer<float> buffer( numChannels, blockSize );
+    juce::MidiBuffer midiBuffer;
+
+    juce::int64 readPosition   = 0;
+    juce::int64 samplesToSkip  = processor.getLatencySamples();
+    juce::int64 samplesWritten = 0;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    while ( samplesWritten < totalSamples )
+    {
+        reader->read( &buffer, 0, blockSize, readPosition, true, true );
+        readPosition += blockSize;
+
+        processor.processBlock( buffer, midiBuffer );
+
+        const int offset  = static_cast<int>( std::min<juce::int64>( samplesToSkip, blockSize ));
+        const int toWrite = static_cast<int>( std::min<juce::int64>( blockSize - offset, totalSamples - samplesWritten ));
+
+        samplesToSkip -= offset;
+
+        if ( toWrite > 0 ) {
+            if ( !writer->writeFromAudioSampleBuffer( buffer, offset, toWrite )) {
+                result.error = "could not write to output file " + outputFile.getFullPathName();
+                break;
+            }
+            samplesWritten += toWrite;
+        }
+    }
+    processor.releaseResources();
+
+    result.renderTimeInSeconds = ( juce::Time::getMillisecondCounterHiRes() - startTime ) / 1000.0;
+    result.durationInSeconds   = static_cast<double>( totalSamples ) / sampleRate;
+    result.success = result.error.isEmpty();
+
+    return result;
+}
+
+void OfflineRenderer::report( const Result& result )
+{
+    const juce::ScopedLock lock( logLock );
+
+    if ( !result.success ) {
+        ++failures;
+        std::cerr << result.file.getFileName() << ": " << result.error << std::endl;
+        return;
+    }
+
+    const double throughput = result.renderTimeInSeconds > 0.0 ? result.durationInSeconds / result.renderTimeInSeconds : 0.0;
+
+    std::cout << result.file.getFileName() << ": " << juce::String( result.durationInSeconds, 2 ) << " s of audio rendered in "
+              << juce::String( result.renderTimeInSeconds, 3 ) << " s (" << juce::String( throughput, 1 ) << "x realtime)" << std::endl;
+}
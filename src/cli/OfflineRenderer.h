@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+
+/**
+ * Renders audio files through AudioPluginAudioProcessor without a host.
+ * Each worker thread owns its own processor instance and pulls files from
+ * a shared queue, so a large list of files scales across all available cores.
+ */
+class OfflineRenderer
+{
+    public:
+        struct Settings
+        {
+            juce::File outputDirectory;
+            juce::MemoryBlock state; // as written by AudioProcessor::getStateInformation(), can be empty
+            int blockSize  = 512;
+            int numThreads = 0; // 0 = one thread per available CPU core
+            juce::uint32 seed = 0; // applied to every file, so renders are reproducible
+        };
+
+        struct Result
+        {
+            juce::File file;
+            bool success = false;
+            juce::String error;
+            double durationInSeconds  = 0.0; // of the rendered audio
+            double renderTimeInSeconds = 0.0; // wall clock time spent rendering
+        };
+
+        explicit OfflineRenderer( const Settings& settings );
+
+        /**
+         * Renders all provided files and returns the amount of files
+         * that failed to render (e.g. can be used as the process exit code)
+         */
+        int render( const juce::Array<juce::File>& files );
+
+        // the file the render of given input file is written to (inside the output directory)
+        juce::File getOutputFile( const juce::File& file ) const;
+
+        static bool isSupportedFile( const juce::File& file );
+
+    private:
+        class Worker;
+
+        Settings settings;
+        juce::AudioFormatManager formatManager;
+
+        const juce::Array<juce::File>* queue = nullptr;
+        std::atomic<int> nextFileIndex { 0 };
+        std::atomic<int> failures { 0 };
+        juce::CriticalSection logLock;
+
+        Result renderFile( juce::AudioProcessor& processor, const juce::File& file );
+        void report( const Result& result );
+};
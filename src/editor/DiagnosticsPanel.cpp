@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DiagnosticsPanel.h"
+
+/* constructor / destructor */
+
+DiagnosticsPanel::DiagnosticsPanel( Profiler& p ) : profiler( p )
+{
+    addAndMakeVisible( resetButton );
+    resetButton.onClick = [ this ] { profiler.reset(); };
+}
+
+DiagnosticsPanel::~DiagnosticsPanel()
+{
+    if ( isVisible()) {
+        profiler.setEnabled( wasEnabled );
+    }
+}
+
+/* public methods */
+
+void DiagnosticsPanel::paint( juce::Graphics& g )
+{
+    g.fillAll( juce::Colour( Styles::BACKGROUND_COLOR ).withAlpha( 0.95f ));
+
+    auto bounds = getLocalBounds().reduced( MARGIN );
+    auto header = bounds.removeFromTop( HEADER_HEIGHT - MARGIN );
+
+    g.setColour( juce::Colours::white );
+    g.setFont( 16.0f );
+    g.drawText( "Processing time per block", header, juce::Justification::centredLeft );
+
+    // one row per stage followed by the block time relative to the deadline
+
+    const int rowHeight = bounds.getHeight() / ( Profiler::NumStages + 1 );
+
+    for ( int stage = 0; stage < Profiler::NumStages; ++stage ) {
+        const auto snapshot = profiler.getStage( static_cast<Profiler::Stage>( stage ));
+        const juce::String details = snapshot.count == 0 ? "inactive" :
+            "mean " + juce::String( snapshot.mean, 1 ) + " us, max " + juce::String( snapshot.max, 1 ) + " us";
+
+        paintHistogram( g, bounds.removeFromTop( rowHeight ), Profiler::getStageName( static_cast<Profiler::Stage>( stage )),
+                        details, snapshot, -1 );
+    }
+
+    const auto deadline = profiler.getDeadline();
+    const juce::String details = "mean " + juce::String( deadline.mean, 1 ) + " %, max " + juce::String( deadline.max, 1 ) +
+                                 " %, " + juce::String( static_cast<int>( profiler.getOverruns())) + " of " +
+                                 juce::String( static_cast<int>( deadline.count )) + " blocks overran";
+
+    paintHistogram( g, bounds.removeFromTop( rowHeight ), "Block vs. deadline", details, deadline, 100 / Profiler::DEADLINE_STEP );
+}
+
+void DiagnosticsPanel::resized()
+{
+    const int width = 60;
+    resetButton.setBounds( getWidth() - ( width + MARGIN ), MARGIN, width, HEADER_HEIGHT - MARGIN * 2 + 4 );
+}
+
+void DiagnosticsPanel::visibilityChanged()
+{
+    // the blocks are measured while the panel is shown, after which the profiler is restored
+    // to its prior state (e.g. when it was enabled through AudioPluginAudioProcessor::getProfiler())
+
+    if ( isVisible()) {
+        wasEnabled = profiler.isEnabled();
+        profiler.setEnabled( true );
+        startTimerHz( REFRESH_RATE );
+    } else {
+        profiler.setEnabled( wasEnabled );
+        stopTimer();
+    }
+}
+
+/* private methods */
+
+void DiagnosticsPanel::timerCallback()
+{
+    repaint();
+}
+
+void DiagnosticsPanel::paintHistogram( juce::Graphics& g, juce::Rectangle<int> bounds, const juce::String& title,
+                                       const juce::String& details, const Profiler::Snapshot& snapshot, int highlightBin )
+{
+    bounds.removeFromBottom( 6 );
+
+    auto label = bounds.removeFromTop( 16 );
+
+    g.setColour( juce::Colours::white );
+    g.setFont( 12.0f );
+    g.drawText( title, label, juce::Justification::centredLeft );
+    g.setColour( juce::Colours::lightgrey );
+    g.drawText( details, label, juce::Justification::centredRight );
+
+    juce::uint32 fullest = 0;
+    for ( const auto count : snapshot.bins ) {
+        fullest = std::max( fullest, count );
+    }
+
+    const float barWidth = static_cast<float>( bounds.getWidth()) / Profiler::NUM_BINS;
+
+    for ( int bin = 0; bin < Profiler::NUM_BINS; ++bin ) {
+        const float fill = fullest > 0 ? static_cast<float>( snapshot.bins[ static_cast<size_t>( bin )]) / fullest : 0.f;
+        const float x    = static_cast<float>( bounds.getX()) + bin * barWidth;
+
+        g.setColour( juce::Colours::black.withAlpha( 0.25f ));
+        g.fillRect( x + 1.f, static_cast<float>( bounds.getY()), barWidth - 2.f, static_cast<float>( bounds.getHeight()));
+
+        g.setColour( highlightBin >= 0 && bin >= highlightBin ? juce::Colours::red : juce::Colour( Styles::HIGHLIGHT_COLOR ));
+        const float height = fill * bounds.getHeight();
+        g.fillRect( x + 1.f, bounds.getBottom() - height, barWidth - 2.f, height );
+    }
+}
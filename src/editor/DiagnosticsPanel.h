@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Styles.h"
+#include "../utils/Profiler.h"
+
+/**
+ * Overlay displaying the measurements of the Profiler : the distribution of the time spent per block on
+ * each processing stage and of the time spent on the whole block relative to its deadline (where
+ * the bins exceeding the deadline are highlighted). The profiler is enabled while the panel is visible.
+ */
+class DiagnosticsPanel final : public juce::Component, private juce::Timer
+{
+    public:
+        explicit DiagnosticsPanel( Profiler& profiler );
+        ~DiagnosticsPanel() override;
+
+        void paint( juce::Graphics& g ) override;
+        void resized() override;
+        void visibilityChanged() override;
+
+    private:
+        static constexpr int REFRESH_RATE  = 10; // in Hz
+        static constexpr int HEADER_HEIGHT = 40;
+        static constexpr int MARGIN        = 12;
+
+        Profiler& profiler;
+        bool wasEnabled = false; // whether the profiler was enabled before the panel was shown
+        juce::TextButton resetButton { "Reset" };
+
+        void timerCallback() override;
+
+        // draws the bins of a snapshot as bars (scaled to the fullest bin), bins from highlightBin onwards
+        // are drawn in the warning colour (e.g. deadline overruns, -1 to highlight none)
+        void paintHistogram( juce::Graphics& g, juce::Rectangle<int> bounds, const juce::String& title,
+                             const juce::String& details, const Profiler::Snapshot& snapshot, int highlightBin );
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR( DiagnosticsPanel )
+};
@@ -21,7 +21,8 @@
 
 //==============================================================================
 AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor( AudioPluginAudioProcessor& p, juce::AudioProcessorValueTreeState& state )
-    : AudioProcessorEditor( &p ), parameters( state ), audioProcessor( p )
+    : AudioProcessorEditor( &p ), parameters( state ), audioProcessor( p ), diagnosticsPanel( p.getProfiler()),
+      spectrumDisplay( p.getAnalysisTap(), state )
 {
     scaledWidth  = static_cast<int>( ceil( Styles::WIDTH / 2 ));
     scaledHeight = static_cast<int>( ceil( Styles::HEIGHT / 2 ));
@@ -52,6 +53,37 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor( AudioPluginAud
     loDistTypeControl.setLookAndFeel( &smallRotaryLNF );
     hiDistTypeControl.setLookAndFeel( &smallRotaryLNF );
 
+    // the diagnostics panel (see Profiler)
+
+    addChildComponent( diagnosticsPanel );
+    addAndMakeVisible( diagnosticsButton );
+
+    diagnosticsButton.setClickingTogglesState( true );
+    diagnosticsButton.onClick = [ this ] {
+        diagnosticsPanel.setVisible( diagnosticsButton.getToggleState());
+        if ( diagnosticsButton.getToggleState()) {
+            spectrumButton.setToggleState( false, juce::sendNotification );
+        }
+    };
+
+    // the spectrum display (see AnalysisTap), only one overlay is shown at a time
+
+    addChildComponent( spectrumDisplay );
+    addAndMakeVisible( spectrumButton );
+
+    spectrumButton.setClickingTogglesState( true );
+    spectrumButton.onClick = [ this ] {
+        spectrumDisplay.setVisible( spectrumButton.getToggleState());
+        if ( spectrumButton.getToggleState()) {
+            diagnosticsButton.setToggleState( false, juce::sendNotification );
+        }
+    };
+
+    // the program menu
+
+    addAndMakeVisible( programsButton );
+    programsButton.onClick = [ this ] { showProgramMenu(); };
+
     // add listeners
 
     audioProcessor.parameters.addParameterListener( Parameters::LINK_ENABLED, this );
@@ -101,6 +133,77 @@ void AudioPluginAudioProcessorEditor::parameterChanged( const juce::String& id,
     }
 }
 
+void AudioPluginAudioProcessorEditor::showProgramMenu()
+{
+    // the menu item IDs of the programs are their index + 1 (as 0 is reserved for dismissing the menu)
+
+    static constexpr int SAVE_ITEM   = PresetBank::MAX_PRESETS + 1;
+    static constexpr int RENAME_ITEM = PresetBank::MAX_PRESETS + 2;
+
+    const int numPrograms        = audioProcessor.getNumPrograms();
+    const int numFactoryPrograms = audioProcessor.getNumFactoryPrograms();
+    const int currentProgram     = audioProcessor.getCurrentProgram();
+
+    juce::PopupMenu menu;
+
+    for ( int index = 0; index < numPrograms; ++index ) {
+        if ( index == numFactoryPrograms ) {
+            menu.addSeparator(); // the user presets follow the factory presets
+        }
+        menu.addItem( index + 1, audioProcessor.getProgramName( index ), true, index == currentProgram );
+    }
+    menu.addSeparator();
+    menu.addItem( SAVE_ITEM, "Save as new preset..." );
+    menu.addItem( RENAME_ITEM, "Rename preset...", currentProgram >= numFactoryPrograms );
+
+    juce::Component::SafePointer<AudioPluginAudioProcessorEditor> editor( this );
+
+    menu.showMenuAsync( juce::PopupMenu::Options().withTargetComponent( &programsButton ), [ editor, currentProgram ]( int result ) {
+        if ( editor == nullptr || result == 0 ) {
+            return;
+        }
+        auto& processor = editor->audioProcessor;
+
+        if ( result == SAVE_ITEM ) {
+            editor->showProgramNameDialog( "Save as new preset", "Preset " + juce::String( processor.getNumPrograms() + 1 ), [ editor ]( const juce::String& name ) {
+                if ( editor != nullptr && editor->audioProcessor.saveProgram( name ) < 0 ) {
+                    juce::AlertWindow::showMessageBoxAsync(
+                        juce::MessageBoxIconType::WarningIcon, "Save as new preset", "The maximum amount of presets has been reached."
+                    );
+                }
+            });
+        } else if ( result == RENAME_ITEM ) {
+            editor->showProgramNameDialog( "Rename preset", processor.getProgramName( currentProgram ), [ editor, currentProgram ]( const juce::String& name ) {
+                if ( editor != nullptr ) {
+                    editor->audioProcessor.changeProgramName( currentProgram, name );
+                }
+            });
+        } else {
+            processor.setCurrentProgram( result - 1 );
+            processor.updateHostDisplay( juce::AudioProcessor::ChangeDetails().withProgramChanged( true ));
+        }
+    });
+}
+
+void AudioPluginAudioProcessorEditor::showProgramNameDialog( const juce::String& title, const juce::String& name, std::function<void( const juce::String& )> onConfirm )
+{
+    auto* dialog = new juce::AlertWindow( title, "Enter the name of the preset", juce::MessageBoxIconType::NoIcon, this );
+
+    dialog->addTextEditor( "name", name );
+    dialog->addButton( "OK", 1, juce::KeyPress( juce::KeyPress::returnKey ));
+    dialog->addButton( "Cancel", 0, juce::KeyPress( juce::KeyPress::escapeKey ));
+
+    // the dialog deletes itself once dismissed (after invoking the callback)
+
+    dialog->enterModalState( true, juce::ModalCallbackFunction::create([ dialog, onConfirm ]( int result ) {
+        const auto value = dialog->getTextEditorContents( "name" ).trim();
+
+        if ( result == 1 && value.isNotEmpty()) {
+            onConfirm( value );
+        }
+    }), true );
+}
+
 void AudioPluginAudioProcessorEditor::setControlEnabled( juce::Slider& control, bool enabled )
 {
     control.setEnabled( enabled );
@@ -149,4 +252,12 @@ void AudioPluginAudioProcessorEditor::resized()
     hiDistInputControl.setBounds( hiDistSlidersX, distSlidersY, Styles::SLIDER_WIDTH, Styles::SLIDER_HEIGHT );
     hiDistDriveControl.setBounds( hiDistSlidersX, distSlidersY + Styles::SLIDER_MARGIN, Styles::SLIDER_WIDTH, Styles::SLIDER_HEIGHT );
     hiDistParamControl.setBounds( hiDistSlidersX, distSlidersY + Styles::SLIDER_MARGIN * 2, Styles::SLIDER_WIDTH, Styles::SLIDER_HEIGHT );
+
+    diagnosticsPanel.setBounds( getLocalBounds().withTrimmedBottom( 40 ));
+    diagnosticsButton.setBounds( 21, scaledHeight - 34, 40, Styles::SLIDER_HEIGHT );
+
+    spectrumDisplay.setBounds( getLocalBounds().withTrimmedBottom( 40 ));
+    spectrumButton.setBounds( 65, scaledHeight - 34, 40, Styles::SLIDER_HEIGHT );
+
+    programsButton.setBounds( 209, scaledHeight - 34, 40, Styles::SLIDER_HEIGHT );
 }
\ No newline at end of file
@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include "DiagnosticsPanel.h"
+#include "SpectrumDisplay.h"
 #include "ThinRotaryLookAndFeel.h"
 #include "Styles.h"
 #include "../PluginProcessor.h"
@@ -74,6 +76,20 @@ class AudioPluginAudioProcessorEditor final : public juce::AudioProcessorEditor,
         std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> hiDistDriveAtt;
         std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> hiDistParamAtt;
 
+        // diagnostics and analysis (the panels overlay the controls, toggled by their buttons)
+
+        DiagnosticsPanel diagnosticsPanel;
+        juce::TextButton diagnosticsButton { "CPU" };
+        SpectrumDisplay spectrumDisplay;
+        juce::TextButton spectrumButton { "FFT" };
+
+        // the programs (see PresetBank), listed in a menu along with the options to save and rename user presets
+
+        juce::TextButton programsButton { "PRG" };
+
+        void showProgramMenu();
+        void showProgramNameDialog( const juce::String& title, const juce::String& name, std::function<void( const juce::String& )> onConfirm );
+
         // styles
 
         ThinRotaryLookAndFeel largeRotaryLNF;
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SpectrumDisplay.h"
+#include "../Parameters.h"
+
+/* constructor / destructor */
+
+SpectrumDisplay::SpectrumDisplay( AnalysisTap& t, juce::AudioProcessorValueTreeState& state ) : tap( t ), parameters( state )
+{
+    setInterceptsMouseClicks( false, false );
+}
+
+SpectrumDisplay::~SpectrumDisplay()
+{
+    if ( isVisible()) {
+        tap.removeConsumer();
+    }
+}
+
+/* public methods */
+
+void SpectrumDisplay::paint( juce::Graphics& g )
+{
+    g.fillAll( juce::Colour( Styles::BACKGROUND_COLOR ).withAlpha( 0.95f ));
+
+    const auto bounds = getLocalBounds().reduced( MARGIN ).toFloat();
+
+    // frequency grid
+
+    g.setFont( 10.0f );
+
+    for ( const float frequency : { 100.f, 1000.f, 10000.f }) {
+        const float x = getX( bounds, frequency );
+
+        g.setColour( juce::Colours::black.withAlpha( 0.25f ));
+        g.drawVerticalLine( juce::roundToInt( x ), bounds.getY(), bounds.getBottom());
+        g.setColour( juce::Colours::lightgrey );
+        g.drawText( frequency < 1000.f ? juce::String( juce::roundToInt( frequency )) : juce::String( juce::roundToInt( frequency / 1000.f )) + "k",
+                    juce::Rectangle<float>( x + 2.f, bounds.getY(), 30.f, 12.f ), juce::Justification::centredLeft );
+    }
+
+    if ( levels.hasMask ) {
+        // harmonic split : shade the harmonic mask
+
+        juce::Path mask;
+        mask.startNewSubPath( bounds.getBottomLeft());
+
+        for ( int point = 0; point < AnalysisTap::NUM_POINTS; ++point ) {
+            const float x = getX( bounds, AnalysisTap::getPointFrequency( point ));
+            const float y = bounds.getBottom() - levels.mask[ static_cast<size_t>( point )] * bounds.getHeight();
+
+            mask.lineTo( x, y );
+            mask.lineTo( getX( bounds, AnalysisTap::getPointFrequency( point + 1 )), y );
+        }
+        mask.lineTo( bounds.getBottomRight());
+        mask.closeSubPath();
+
+        g.setColour( juce::Colour( Styles::HIGHLIGHT_COLOR ).withAlpha( 0.15f ));
+        g.fillPath( mask );
+    } else {
+        // EQ split : mark the splits between the bands
+
+        g.setColour( juce::Colour( Styles::HIGHLIGHT_COLOR ).withAlpha( 0.6f ));
+
+        for ( int split = 0; split < levels.numBands - 1; ++split ) {
+            const float frequency = parameters.getRawParameterValue( Parameters::SPLITS[ split ])->load();
+            g.drawVerticalLine( juce::roundToInt( getX( bounds, frequency )), bounds.getY(), bounds.getBottom());
+        }
+    }
+
+    // the input spectrum as a filled area, the bands as outlines on top
+
+    auto input = createPath( bounds, levels.input );
+
+    g.setColour( juce::Colours::white.withAlpha( 0.2f ));
+    g.strokePath( input, juce::PathStrokeType( 1.0f ));
+
+    input.lineTo( bounds.getBottomRight());
+    input.lineTo( bounds.getBottomLeft());
+    input.closeSubPath();
+
+    g.setColour( juce::Colours::white.withAlpha( 0.1f ));
+    g.fillPath( input );
+
+    for ( int band = 0; band < levels.numBands; ++band ) {
+        // in the harmonic split the first band is the harmonic content
+
+        const float hue = levels.hasMask ? ( band == 0 ? 0.15f : 0.55f ) : static_cast<float>( band ) / AnalysisTap::MAX_BANDS;
+
+        g.setColour( juce::Colour::fromHSV( hue, 0.6f, 0.9f, 0.9f ));
+        g.strokePath( createPath( bounds, levels.bands[ static_cast<size_t>( band )]), juce::PathStrokeType( 1.5f ));
+    }
+}
+
+void SpectrumDisplay::visibilityChanged()
+{
+    // the tap only publishes spectra while the display is shown
+
+    if ( isVisible()) {
+        levels.input.fill( AnalysisTap::MIN_DECIBELS );
+        for ( auto& band : levels.bands ) {
+            band.fill( AnalysisTap::MIN_DECIBELS );
+        }
+        tap.addConsumer();
+        startTimerHz( REFRESH_RATE );
+    } else {
+        tap.removeConsumer();
+        stopTimer();
+    }
+}
+
+/* private methods */
+
+void SpectrumDisplay::timerCallback()
+{
+    if ( !tap.update()) {
+        return;
+    }
+    const auto& spectra = tap.getSpectra();
+
+    // rising levels are shown immediately, falling levels are released gradually
+
+    auto release = []( std::array<float, AnalysisTap::NUM_POINTS>& current, const std::array<float, AnalysisTap::NUM_POINTS>& target ) {
+        for ( size_t point = 0; point < current.size(); ++point ) {
+            current[ point ] = std::max( target[ point ], current[ point ] * RELEASE + target[ point ] * ( 1.f - RELEASE ));
+        }
+    };
+
+    release( levels.input, spectra.input );
+
+    for ( size_t band = 0; band < levels.bands.size(); ++band ) {
+        release( levels.bands[ band ], spectra.bands[ band ]);
+    }
+    levels.mask     = spectra.mask;
+    levels.numBands = spectra.numBands;
+    levels.hasMask  = spectra.hasMask;
+
+    repaint();
+}
+
+float SpectrumDisplay::getX( juce::Rectangle<float> bounds, float frequency ) const
+{
+    const float position = std::log( juce::jlimit( AnalysisTap::MIN_FREQUENCY, AnalysisTap::MAX_FREQUENCY, frequency ) / AnalysisTap::MIN_FREQUENCY ) /
+                           std::log( AnalysisTap::MAX_FREQUENCY / AnalysisTap::MIN_FREQUENCY );
+
+    return bounds.getX() + position * bounds.getWidth();
+}
+
+float SpectrumDisplay::getY( juce::Rectangle<float> bounds, float decibels ) const
+{
+    const float position = ( juce::jlimit( AnalysisTap::MIN_DECIBELS, MAX_DECIBELS, decibels ) - AnalysisTap::MIN_DECIBELS ) /
+                           ( MAX_DECIBELS - AnalysisTap::MIN_DECIBELS );
+
+    return bounds.getBottom() - position * bounds.getHeight();
+}
+
+juce::Path SpectrumDisplay::createPath( juce::Rectangle<float> bounds, const std::array<float, AnalysisTap::NUM_POINTS>& points ) const
+{
+    juce::Path path;
+
+    for ( int point = 0; point < AnalysisTap::NUM_POINTS; ++point ) {
+        // each point covers the range up to the next point, drawn at its (logarithmic) centre
+
+        const float x = getX( bounds, std::sqrt( AnalysisTap::getPointFrequency( point ) * AnalysisTap::getPointFrequency( point + 1 )));
+        const float y = getY( bounds, points[ static_cast<size_t>( point )]);
+
+        if ( point == 0 ) {
+            path.startNewSubPath( x, y );
+        } else {
+            path.lineTo( x, y );
+        }
+    }
+    return path;
+}
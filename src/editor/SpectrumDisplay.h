@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Styles.h"
+#include "../modules/analysis/AnalysisTap.h"
+
+/**
+ * Overlay displaying the spectra published by the AnalysisTap : the input as a filled area and the
+ * bands as lines on a logarithmic frequency axis. For the EQ split the split frequencies are marked,
+ * for the harmonic split the harmonic mask is shaded. The display registers as a consumer of the tap
+ * only while it is visible, so the audio thread skips the tap when it is not shown (or the editor is closed).
+ */
+class SpectrumDisplay final : public juce::Component, private juce::Timer
+{
+    public:
+        SpectrumDisplay( AnalysisTap& tap, juce::AudioProcessorValueTreeState& parameters );
+        ~SpectrumDisplay() override;
+
+        void paint( juce::Graphics& g ) override;
+        void visibilityChanged() override;
+
+    private:
+        static constexpr int REFRESH_RATE = 30; // in Hz
+        static constexpr int MARGIN       = 12;
+
+        static constexpr float MAX_DECIBELS = 0.f;
+        static constexpr float RELEASE      = 0.8f; // the amount of the previous frame kept when a level falls
+
+        AnalysisTap& tap;
+        juce::AudioProcessorValueTreeState& parameters;
+        AnalysisTap::Spectra levels; // the displayed spectra, falling gradually to steady the display
+
+        void timerCallback() override;
+
+        float getX( juce::Rectangle<float> bounds, float frequency ) const;
+        float getY( juce::Rectangle<float> bounds, float decibels ) const;
+
+        // the outline of provided display points
+        juce::Path createPath( juce::Rectangle<float> bounds, const std::array<float, AnalysisTap::NUM_POINTS>& points ) const;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR( SpectrumDisplay )
+};
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AnalysisTap.h"
+
+/* constructor */
+
+AnalysisTap::AnalysisTap()
+{
+    // allocate for the largest FFT of the harmonic split, so publishing never allocates
+
+    const size_t maxBins = Parameters::FFT::MAX_SIZE / 2 + 1;
+
+    frames.forEachBuffer([]( Frame& frame ) {
+        frame.samples.resize( static_cast<size_t>( FRAME_SIZE * ( MAX_BANDS + 1 )), 0.f );
+    });
+    _history.resize( static_cast<size_t>( FRAME_SIZE * ( MAX_BANDS + 1 )), 0.f );
+    _power.resize( maxBins, 0.f );
+    _weights.resize( maxBins, 0.f );
+
+    // the consumer applies a (periodic) Hann window, the scale normalises a full scale sine to 0 dB
+
+    _window.resize( static_cast<size_t>( FRAME_SIZE ));
+    _fftBuffer.resize( static_cast<size_t>( FRAME_SIZE * 2 ), 0.f );
+
+    double windowSum = 0.0;
+
+    for ( size_t n = 0; n < _window.size(); ++n ) {
+        const double hann = 0.5 - 0.5 * std::cos( 2.0 * juce::MathConstants<double>::pi * ( double ) n / FRAME_SIZE );
+        _window[ n ] = static_cast<float>( hann );
+        windowSum   += hann;
+    }
+    _windowScale = static_cast<float>( 2.0 / windowSum );
+
+    for ( int point = 0; point <= NUM_POINTS; ++point ) {
+        _pointFrequencies[ static_cast<size_t>( point )] = getPointFrequency( point );
+    }
+}
+
+/* public methods */
+
+void AnalysisTap::prepare( double sampleRate )
+{
+    _sampleRate.store( sampleRate, std::memory_order_relaxed );
+}
+
+float AnalysisTap::getPointFrequency( int point )
+{
+    return MIN_FREQUENCY * std::pow( MAX_FREQUENCY / MIN_FREQUENCY, static_cast<float>( point ) / NUM_POINTS );
+}
+
+void AnalysisTap::addConsumer()
+{
+    consumers.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void AnalysisTap::removeConsumer()
+{
+    consumers.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+void AnalysisTap::pushSamples( const float* input, const float* const* bands, int numBands, int numSamples )
+{
+    numBands = juce::jlimit( 0, MAX_BANDS, numBands );
+
+    const auto frameSize = static_cast<size_t>( FRAME_SIZE );
+
+    // only the last FRAME_SIZE samples are kept
+
+    size_t offset    = static_cast<size_t>( juce::jmax( 0, numSamples - FRAME_SIZE ));
+    size_t remaining = static_cast<size_t>( numSamples ) - offset;
+
+    while ( remaining > 0 )
+    {
+        const size_t amount = std::min( remaining, frameSize - _historyPosition );
+
+        for ( int signal = 0; signal <= numBands; ++signal ) {
+            const float* source = signal == 0 ? input : ( bands != nullptr ? bands[ signal - 1 ] : nullptr );
+            float* history = _history.data() + static_cast<size_t>( signal ) * frameSize + _historyPosition;
+
+            if ( source != nullptr ) {
+                std::copy( source + offset, source + offset + amount, history );
+            } else {
+                std::fill( history, history + amount, 0.f );
+            }
+        }
+        _historyPosition = ( _historyPosition + amount ) % frameSize;
+        offset    += amount;
+        remaining -= amount;
+    }
+
+    if ( !requested.exchange( false, std::memory_order_acquire )) {
+        return;
+    }
+
+    // hand the history (oldest sample first) over to the consumer
+
+    auto& frame = frames.getWriteBuffer();
+
+    for ( int signal = 0; signal <= numBands; ++signal ) {
+        const float* history = _history.data() + static_cast<size_t>( signal ) * frameSize;
+        float* samples = frame.samples.data() + static_cast<size_t>( signal ) * frameSize;
+
+        std::copy( history + _historyPosition, history + frameSize, samples );
+        std::copy( history, history + _historyPosition, samples + ( frameSize - _historyPosition ));
+    }
+    frame.hasSamples = true;
+    frame.spectra.numBands = numBands;
+    frame.spectra.hasMask  = false;
+
+    frames.publish();
+}
+
+void AnalysisTap::pushSpectrum( const float* spectrum, int fftSize, float scale, const HarmonicMask::Mask* mask )
+{
+    if ( !requested.exchange( false, std::memory_order_acquire )) {
+        return;
+    }
+    const auto numBins = static_cast<size_t>( fftSize / 2 );
+
+    for ( size_t bin = 0; bin <= numBins; ++bin ) {
+        const float real = spectrum[ bin * 2 ] * scale;
+        const float imag = spectrum[ bin * 2 + 1 ] * scale;
+
+        _power[ bin ] = real * real + imag * imag;
+    }
+    std::fill( _weights.begin(), _weights.begin() + static_cast<std::ptrdiff_t>( numBins + 1 ), 0.f );
+
+    if ( mask != nullptr && mask->fftSize == fftSize ) {
+        for ( const auto& entry : mask->entries ) {
+            _weights[ entry.bin ] = entry.weight;
+        }
+    }
+
+    // the harmonic band is the spectrum weighted by the mask, the remaining band is weighted by its inverse (see FFT::split())
+
+    auto& spectra = frames.getWriteBuffer().spectra;
+
+    decimate( fftSize, spectra.input, [ this ]( size_t bin ) { return _power[ bin ]; });
+    decimate( fftSize, spectra.bands[ 0 ], [ this ]( size_t bin ) { return _power[ bin ] * _weights[ bin ] * _weights[ bin ]; });
+    decimate( fftSize, spectra.bands[ 1 ], [ this ]( size_t bin ) {
+        const float weight = 1.f - _weights[ bin ];
+        return _power[ bin ] * weight * weight;
+    });
+    decimate( fftSize, spectra.mask, [ this ]( size_t bin ) { return _weights[ bin ]; });
+
+    toDecibels( spectra.input );
+    toDecibels( spectra.bands[ 0 ]);
+    toDecibels( spectra.bands[ 1 ]);
+
+    spectra.numBands = 2;
+    spectra.hasMask  = true;
+    frames.getWriteBuffer().hasSamples = false;
+
+    frames.publish();
+}
+
+bool AnalysisTap::update()
+{
+    if ( !frames.update()) {
+        return false;
+    }
+    const auto& frame = frames.getReadBuffer();
+
+    if ( !frame.hasSamples ) {
+        _spectra = frame.spectra;
+    } else {
+        // compute the spectra of the samples of the EQ split
+
+        const auto frameSize = static_cast<size_t>( FRAME_SIZE );
+
+        _spectra.numBands = frame.spectra.numBands;
+        _spectra.hasMask  = false;
+
+        for ( int signal = 0; signal <= _spectra.numBands; ++signal ) {
+            const float* samples = frame.samples.data() + static_cast<size_t>( signal ) * frameSize;
+            auto& points = signal == 0 ? _spectra.input : _spectra.bands[ static_cast<size_t>( signal - 1 )];
+
+            for ( size_t i = 0; i < frameSize; ++i ) {
+                _fftBuffer[ i ] = samples[ i ] * _window[ i ];
+            }
+            std::fill( _fftBuffer.begin() + static_cast<std::ptrdiff_t>( frameSize ), _fftBuffer.end(), 0.f );
+
+            _fft.performFrequencyOnlyForwardTransform( _fftBuffer.data(), true );
+
+            decimate( FRAME_SIZE, points, [ this ]( size_t bin ) {
+                const float magnitude = _fftBuffer[ bin ] * _windowScale;
+                return magnitude * magnitude;
+            });
+            toDecibels( points );
+        }
+    }
+    requested.store( true, std::memory_order_release );
+
+    return true;
+}
+
+/* private methods */
+
+template <typename Function>
+void AnalysisTap::decimate( int fftSize, std::array<float, NUM_POINTS>& points, Function&& getBin ) const
+{
+    const int numBins = fftSize / 2;
+    const double binsPerHertz = fftSize / _sampleRate.load( std::memory_order_relaxed );
+
+    for ( size_t point = 0; point < points.size(); ++point ) {
+        // the bins from the frequency of this point up to that of the next point (at least one bin)
+
+        const int first = juce::jlimit( 0, numBins, static_cast<int>( std::lround( _pointFrequencies[ point ] * binsPerHertz )));
+        const int last  = juce::jlimit( first, numBins, static_cast<int>( std::lround( _pointFrequencies[ point + 1 ] * binsPerHertz )) - 1 );
+
+        float value = getBin( static_cast<size_t>( first ));
+
+        for ( int bin = first + 1; bin <= last; ++bin ) {
+            value = std::max( value, getBin( static_cast<size_t>( bin )));
+        }
+        points[ point ] = value;
+    }
+}
+
+void AnalysisTap::toDecibels( std::array<float, NUM_POINTS>& points )
+{
+    const float minPower = std::pow( 10.f, MIN_DECIBELS / 10.f );
+
+    for ( auto& value : points ) {
+        value = 10.f * std::log10( std::max( value, minPower ));
+    }
+}
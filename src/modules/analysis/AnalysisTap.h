@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "../../Parameters.h"
+#include "../../utils/TripleBuffer.h"
+#include "../fft/HarmonicMask.h"
+
+/**
+ * Publishes the spectra of the input and the bands of the first channel (prior to distortion) to a display
+ * (e.g. the editor), without locking.
+ *
+ * For the EQ split, the audio thread keeps a history of the most recent FRAME_SIZE samples of the input and the bands,
+ * which is handed to the consumer to compute their spectra. For the harmonic split, the spectrum computed by FFT::split()
+ * is reused : the audio thread decimates the spectrum, its harmonic and its remaining content and the harmonic mask into
+ * NUM_POINTS display points, without additional transforms. In both cases a frame is only published once the consumer has
+ * picked up the previous one, so the producer publishes at the rate at which the display refreshes.
+ *
+ * The tap is only active while a consumer is registered (see addConsumer()), when inactive the audio thread skips it entirely.
+ */
+class AnalysisTap
+{
+    public:
+        static constexpr int FRAME_ORDER = 11; // the FFT order of the spectra of the EQ split
+        static constexpr int FRAME_SIZE  = 1 << FRAME_ORDER;
+        static constexpr int NUM_POINTS  = 128; // logarithmically spaced between MIN_FREQUENCY and MAX_FREQUENCY
+        static constexpr int MAX_BANDS   = Parameters::MAX_BANDS;
+
+        static constexpr float MIN_FREQUENCY = 20.f;
+        static constexpr float MAX_FREQUENCY = 20000.f;
+        static constexpr float MIN_DECIBELS  = -100.f; // the level of silence
+
+        // the spectra at the display points, in decibels (relative to a full scale sine)
+
+        struct Spectra
+        {
+            std::array<float, NUM_POINTS> input {};
+            std::array<std::array<float, NUM_POINTS>, MAX_BANDS> bands {};
+            std::array<float, NUM_POINTS> mask {}; // the highest weight of the harmonic mask (0 - 1) at each point
+            int numBands = 0;
+            bool hasMask = false; // true for the harmonic split, where the bands are the harmonic and the remaining content
+        };
+
+        AnalysisTap();
+
+        // to be invoked when the sample rate changes (not during processing)
+        void prepare( double sampleRate );
+
+        // the frequency (in Hz) of provided display point
+        static float getPointFrequency( int point );
+
+        /* consumers, e.g. an open editor (thread safe) */
+
+        void addConsumer();
+        void removeConsumer();
+
+        bool isActive() const { return consumers.load( std::memory_order_relaxed ) > 0; }
+
+        /* producer (the audio thread, only while active) */
+
+        // adds numSamples of the input and the bands of the EQ split, bands can be nullptr when they are silent
+        void pushSamples( const float* input, const float* const* bands, int numBands, int numSamples );
+
+        /**
+         * Provides the spectrum of a frame of the harmonic split (as computed by FFT::split(), e.g. the interleaved complex
+         * bins 0 to fftSize / 2) and the mask it was split by. Scale normalises the magnitudes (see FFT::getSpectrumScale())
+         */
+        void pushSpectrum( const float* spectrum, int fftSize, float scale, const HarmonicMask::Mask* mask );
+
+        /* consumer (a single thread, e.g. the message thread) */
+
+        // picks up the most recently published frame, returns true when getSpectra() has been updated
+        bool update();
+        const Spectra& getSpectra() const { return _spectra; }
+
+    private:
+        struct Frame
+        {
+            bool hasSamples = false; // whether the frame holds samples (EQ split) or decimated spectra (harmonic split)
+            std::vector<float> samples; // FRAME_SIZE samples of the input followed by FRAME_SIZE samples of each band
+            Spectra spectra;
+        };
+
+        TripleBuffer<Frame> frames;
+        std::atomic<int> consumers { 0 };
+        std::atomic<bool> requested { true }; // whether the consumer has picked up the last published frame
+
+        std::atomic<double> _sampleRate { 44100.0 }; // read by both the producer and the consumer
+        std::array<float, NUM_POINTS + 1> _pointFrequencies {}; // the lower bound of each point (and the upper bound of the last)
+
+        // producer state
+
+        std::vector<float> _history; // the last FRAME_SIZE samples of the input and each band (as ring buffers)
+        size_t _historyPosition = 0;
+        std::vector<float> _power;   // of each bin of the harmonic split
+        std::vector<float> _weights; // the harmonic mask for each bin of the harmonic split
+
+        // consumer state
+
+        juce::dsp::FFT _fft { FRAME_ORDER };
+        std::vector<float> _window;
+        std::vector<float> _fftBuffer;
+        float _windowScale = 1.f;
+        Spectra _spectra;
+
+        // writes the highest value of the bins (of an FFT of fftSize) within the range of each point into points,
+        // where getBin( bin ) returns the value of a bin
+        template <typename Function>
+        void decimate( int fftSize, std::array<float, NUM_POINTS>& points, Function&& getBin ) const;
+
+        static void toDecibels( std::array<float, NUM_POINTS>& points );
+};
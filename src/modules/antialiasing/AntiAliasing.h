@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cmath>
+
+/**
+ * Antiderivative anti-aliasing (ADAA) for memoryless transfer functions.
+ *
+ * Rather than evaluating the transfer function f at each sample, ADAA evaluates the average of f over the
+ * interval between consecutive samples, using the closed-form antiderivative of f. This acts as a lowpass
+ * on the continuous time output of f, suppressing most of the aliasing caused by the harmonics f introduces,
+ * without oversampling. First order ADAA delays the signal by half a sample, second order by one sample.
+ *
+ * see Parker, Zavalishin, Le Bivic - "Reducing the aliasing of nonlinear waveshaping using continuous-time convolution" (DAFx 2016)
+ * and Chowdhury - "Practical considerations for antiderivative anti-aliasing" (2020) for the ill-conditioning fallbacks
+ */
+class AntiAliasing
+{
+    public:
+        enum class Order {
+            Off = 0,
+            First,
+            Second,
+        };
+
+        /**
+         * The history of a signal, to be kept per processed signal (e.g. per channel per band). The
+         * history holds the unprocessed input, so it remains valid when switching between transfer functions.
+         */
+        struct State
+        {
+            float x1 = 0.f; // previous input
+            float x2 = 0.f; // input before previous input
+
+            void reset() {
+                x1 = x2 = 0.f;
+            }
+
+            // to be invoked with the unprocessed input when processing without anti-aliasing, so the
+            // history is up to date when anti-aliasing is enabled afterwards
+            void push( const float* input, unsigned long bufferSize ) {
+                if ( bufferSize >= 2 ) {
+                    x2 = input[ bufferSize - 2 ];
+                    x1 = input[ bufferSize - 1 ];
+                } else if ( bufferSize == 1 ) {
+                    x2 = x1;
+                    x1 = input[ 0 ];
+                }
+            }
+        };
+
+        /**
+         * Applies first order ADAA in place, where each input sample is multiplied by inputGain before being
+         * processed by function (e.g. the transfer curve) of which integral is the first antiderivative.
+         */
+        template <typename Function, typename Integral>
+        static void applyFirstOrder(
+            float* channelData, unsigned long bufferSize, State& state, double inputGain,
+            const Function& function, const Integral& integral
+        ) {
+            float x1 = state.x1;
+            float x2 = state.x2;
+
+            double previous = x1 * inputGain;
+            double previousIntegral = integral( previous );
+
+            for ( unsigned long i = 0; i < bufferSize; ++i )
+            {
+                const float input = channelData[ i ];
+
+                const double current = input * inputGain;
+                const double currentIntegral = integral( current );
+                const double delta = current - previous;
+
+                // when consecutive samples are (nearly) equal, the division is ill-conditioned and
+                // the function is evaluated at the midpoint instead
+
+                const double output = std::abs( delta ) < FIRST_ORDER_TOLERANCE
+                    ? function( 0.5 * ( current + previous ))
+                    : ( currentIntegral - previousIntegral ) / delta;
+
+                channelData[ i ] = static_cast<float>( output );
+
+                previous = current;
+                previousIntegral = currentIntegral;
+                x2 = x1;
+                x1 = input;
+            }
+            state.x1 = x1;
+            state.x2 = x2;
+        }
+
+        /**
+         * Applies second order ADAA in place, like applyFirstOrder() though additionally requiring
+         * the second antiderivative of function (doubleIntegral)
+         */
+        template <typename Function, typename Integral, typename DoubleIntegral>
+        static void applySecondOrder(
+            float* channelData, unsigned long bufferSize, State& state, double inputGain,
+            const Function& function, const Integral& integral, const DoubleIntegral& doubleIntegral
+        ) {
+            float x1 = state.x1;
+            float x2 = state.x2;
+
+            double previous       = x1 * inputGain;
+            double beforePrevious = x2 * inputGain;
+            double previousDoubleIntegral = doubleIntegral( previous );
+
+            // the first order divided difference between the previous samples
+
+            double previousDifference = getDividedDifference(
+                previous, beforePrevious, previousDoubleIntegral, doubleIntegral( beforePrevious ), integral
+            );
+
+            for ( unsigned long i = 0; i < bufferSize; ++i )
+            {
+                const float input = channelData[ i ];
+
+                const double current = input * inputGain;
+                const double currentDoubleIntegral = doubleIntegral( current );
+                const double currentDifference = getDividedDifference(
+                    current, previous, currentDoubleIntegral, previousDoubleIntegral, integral
+                );
+                const double delta = current - beforePrevious;
+                double output;
+
+                if ( std::abs( delta ) >= SECOND_ORDER_TOLERANCE ) {
+                    output = 2.0 * ( currentDifference - previousDifference ) / delta;
+                } else {
+                    // current and before previous sample are (nearly) equal, integrate
+                    // over the interval between their midpoint and the previous sample
+
+                    const double midpoint = 0.5 * ( current + beforePrevious );
+                    const double distance = midpoint - previous;
+
+                    output = std::abs( distance ) < SECOND_ORDER_TOLERANCE
+                        ? function( 0.5 * ( midpoint + previous ))
+                        : ( 2.0 / distance ) * ( integral( midpoint ) + ( previousDoubleIntegral - doubleIntegral( midpoint )) / distance );
+                }
+                channelData[ i ] = static_cast<float>( output );
+
+                beforePrevious = previous;
+                previous = current;
+                previousDoubleIntegral = currentDoubleIntegral;
+                previousDifference = currentDifference;
+                x2 = x1;
+                x1 = input;
+            }
+            state.x1 = x1;
+            state.x2 = x2;
+        }
+
+    private:
+        // below these distances between samples, the divided differences are considered ill-conditioned
+        // (the second order differences lose more precision, hence its larger tolerance)
+
+        static constexpr double FIRST_ORDER_TOLERANCE  = 1e-5;
+        static constexpr double SECOND_ORDER_TOLERANCE = 1e-3;
+
+        template <typename Integral>
+        static inline double getDividedDifference( double a, double b, double doubleIntegralA, double doubleIntegralB, const Integral& integral ) {
+            const double delta = a - b;
+            return std::abs( delta ) < SECOND_ORDER_TOLERANCE
+                ? integral( 0.5 * ( a + b ))
+                : ( doubleIntegralA - doubleIntegralB ) / delta;
+        }
+};
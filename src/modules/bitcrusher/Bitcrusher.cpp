@@ -24,6 +24,8 @@
 
 BitCrusher::BitCrusher()
 {
+    prepare( DEFAULT_BLOCK_SIZE );
+
     setLevel( Parameters::Config::DIST_INPUT_DEF );
     setDownsampling( Parameters::Config::DIST_DRIVE_DEF );
     setAmount( Parameters::Config::DIST_PARAM_DEF );
@@ -36,51 +38,50 @@ BitCrusher::~BitCrusher()
 
 /* public methods */
 
-void BitCrusher::apply( float* channelData, unsigned long bufferSize )
+void BitCrusher::prepare( int maxBlockSize )
 {
-    float wrapDrive = _crush * ( MAX_BITS - _bits) / ( MAX_BITS - 1 );
-    bool addNoise = _amount > NOISE_THRESHOLD;
-
-    for ( size_t i = 0; i < bufferSize; ++i )
-    {
-        float input = channelData[ i ];
-
-        int jitter = juce::Random::getSystemRandom().nextInt( int( _jitterAmount * _downsampleBase ) + 1 );
-        int effectiveDownsample = juce::jmax( 1, _downsampleBase + jitter );
+    const auto size = static_cast<size_t>( juce::jmax( 1, maxBlockSize ));
 
-        if ( ++_sampleCounter >= effectiveDownsample )
-        {
-            _sampleCounter = 0;
+    _crushed.resize( size );
+    _jitter.resize( size );
+    _noise.resize( size );
 
-            if ( addNoise ) {
-                input += ( juce::Random::getSystemRandom().nextFloat() * 2.0f - 1.0f ) * _noiseAmount;
-            }
-            
-            // apply bit reduction
+    reset();
+}
 
-            float scaled = input * _levels;
-            float crushed = std::floor( scaled ) / _levels;
+void BitCrusher::reset()
+{
+    _sampleCounter = 0;
+    _lastSample    = 0.0f;
+}
 
-            // apply wrap drive
-            
-            crushed *= 1.0f + wrapDrive * 4.0f;
-            crushed = std::fmod( crushed + 1.0f, 2.0f ) - 1.0f;
+void BitCrusher::apply( float* channelData, unsigned long bufferSize, const ParameterRamps* ramps )
+{
+    const unsigned long capacity = static_cast<unsigned long>( _crushed.size());
 
-            // storing lastSample as local state will "bleed across channels" (unless Bitcrusher has
-            // an instance per channel), but that is fine as it adds another nice layer of unpredictability!!
+    for ( unsigned long offset = 0; offset < bufferSize; offset += capacity ) {
+        const unsigned long chunkSize = juce::jmin( capacity, bufferSize - offset );
 
-            _lastSample = crushed;
+        if ( ramps != nullptr ) {
+            applyRampedChunk( channelData + offset, chunkSize, *ramps, offset );
+        } else {
+            applyChunk( channelData + offset, chunkSize );
         }
-        channelData[ i ] = _lastSample * _mixLevel;
     }
 }
 
+void BitCrusher::setSeed( uint32_t seed )
+{
+    _jitterRandom.setSeed( seed );
+    _noiseRandom.setSeed( ~seed );
+}
+
 /* setters */
 
 void BitCrusher::setAmount( float value )
 {
     _amount = value;
-    _bits   = juce::jmap( MathUtilities::inverseNormalize( value ), MIN_BITS, MAX_BITS );
+    _bits   = getBits( value );
     _levels = std::pow( 2.0f, _bits );
 }
 
@@ -89,10 +90,135 @@ void BitCrusher::setDownsampling( float factor )
     _crush          = juce::jlimit( 0.0f, 1.0f, factor );
     _jitterAmount   = _crush * 0.6f;
     _noiseAmount    = _crush * 0.02f;
-    _downsampleBase = 1 + int( _crush * _crush * 80.0f );
+    _downsampleBase = getDownsampleBase( _crush );
+}
+
+void BitCrusher::setOversampling( int factor )
+{
+    _oversampling = juce::jmax( 1, factor );
+    setDownsampling( _crush );
 }
 
 void BitCrusher::setLevel( float value )
 {
     _mixLevel = juce::jlimit( 0.0f, 1.0f, value );
 }
+
+/* private methods */
+
+void BitCrusher::applyChunk( float* channelData, unsigned long bufferSize )
+{
+    float wrapDrive = _crush * ( MAX_BITS - _bits) / ( MAX_BITS - 1 );
+    bool addNoise = _amount > NOISE_THRESHOLD;
+
+    float* crushed = _crushed.data();
+    std::copy( channelData, channelData + bufferSize, crushed );
+
+    // crush every sample up front (allowing the loops to vectorize), the sample and hold pass
+    // below then only picks the crushed values at the (jittered) downsampling positions
+
+    if ( addNoise ) {
+        float* noise = _noise.data();
+        _noiseRandom.fillBipolar( noise, bufferSize );
+
+        for ( size_t i = 0; i < bufferSize; ++i ) {
+            crushed[ i ] += noise[ i ] * _noiseAmount;
+        }
+    }
+    // apply bit reduction and wrap drive
+
+    MathUtilities::applyQuantizeAndWrap( crushed, bufferSize, _levels, 1.0f + wrapDrive * 4.0f );
+
+    // determine the random jitter of the downsampling positions (a value within the [ 0, jitterRange ) range)
+
+    const int jitterRange = int( _jitterAmount * _downsampleBase ) + 1;
+    float* jitter = _jitter.data();
+
+    if ( jitterRange > 1 ) {
+        _jitterRandom.fillUnipolar( jitter, bufferSize );
+    } else {
+        std::fill( jitter, jitter + bufferSize, 0.0f );
+    }
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        int effectiveDownsample = juce::jmax( 1, _downsampleBase + int( jitter[ i ] * jitterRange ));
+
+        if ( ++_sampleCounter >= effectiveDownsample )
+        {
+            _sampleCounter = 0;
+
+            // the held sample (like the sample counter) carries over into the next block, as there
+            // is a BitCrusher instance per channel and band slot it never bleeds across channels
+
+            _lastSample = crushed[ i ];
+        }
+        channelData[ i ] = _lastSample * _mixLevel;
+    }
+}
+
+void BitCrusher::applyRampedChunk( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps, size_t offset )
+{
+    // equal to applyChunk(), with the coefficients computed per sample. Noise and jitter are generated for the
+    // whole chunk when any of its samples requires them (as the ramps are linear, checking both ends suffices)
+
+    const size_t first = ramps.index( offset );
+    const size_t last  = ramps.index( offset + bufferSize - 1 );
+
+    auto getCrush = [ &ramps ]( size_t index ) {
+        return juce::jlimit( 0.0f, 1.0f, ramps.drive[ index ]);
+    };
+    auto getJitterRange = [ this, &getCrush ]( size_t index ) {
+        const float crush = getCrush( index );
+        return int( crush * 0.6f * static_cast<float>( getDownsampleBase( crush ))) + 1;
+    };
+
+    float* crushed = _crushed.data();
+    std::copy( channelData, channelData + bufferSize, crushed );
+
+    if ( ramps.param[ first ] > NOISE_THRESHOLD || ramps.param[ last ] > NOISE_THRESHOLD ) {
+        float* noise = _noise.data();
+        _noiseRandom.fillBipolar( noise, bufferSize );
+
+        for ( size_t i = 0; i < bufferSize; ++i ) {
+            const size_t index = ramps.index( offset + i );
+            const float noiseAmount = ramps.param[ index ] > NOISE_THRESHOLD ? getCrush( index ) * 0.02f : 0.0f;
+
+            crushed[ i ] += noise[ i ] * noiseAmount;
+        }
+    }
+
+    // apply bit reduction and wrap drive
+
+    for ( size_t i = 0; i < bufferSize; ++i ) {
+        const size_t index = ramps.index( offset + i );
+        const float bits   = getBits( ramps.param[ index ]);
+        const float wrapDrive = getCrush( index ) * ( MAX_BITS - bits ) / ( MAX_BITS - 1 );
+
+        crushed[ i ] = MathUtilities::quantizeAndWrap( crushed[ i ], MathUtilities::fastExp2( bits ), 1.0f + wrapDrive * 4.0f );
+    }
+
+    float* jitter = _jitter.data();
+
+    if ( getJitterRange( first ) > 1 || getJitterRange( last ) > 1 ) {
+        _jitterRandom.fillUnipolar( jitter, bufferSize );
+    } else {
+        std::fill( jitter, jitter + bufferSize, 0.0f );
+    }
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const size_t index = ramps.index( offset + i );
+        const float crush  = getCrush( index );
+        const int jitterRange = getJitterRange( index );
+
+        int effectiveDownsample = juce::jmax( 1, getDownsampleBase( crush ) + int( jitter[ i ] * jitterRange ));
+
+        if ( ++_sampleCounter >= effectiveDownsample )
+        {
+            _sampleCounter = 0;
+            _lastSample = crushed[ i ];
+        }
+        channelData[ i ] = _lastSample * juce::jlimit( 0.0f, 1.0f, ramps.level[ index ]);
+    }
+}
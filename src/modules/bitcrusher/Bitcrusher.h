@@ -17,23 +17,40 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../../utils/RandomGenerator.h"
+#include "../smoother/ParameterRamps.h"
 
 class BitCrusher
 {
     static constexpr float MAX_BITS = 16.f;
     static constexpr float MIN_BITS = 1.f;
     static constexpr float NOISE_THRESHOLD = 0.5f;
+    static constexpr int DEFAULT_BLOCK_SIZE = 512;
 
     public:
         BitCrusher();
         ~BitCrusher();
 
-        void apply( float* channelData, unsigned long bufferSize );
+        // allocates the work buffers (blocks larger than maxBlockSize are processed in multiple passes)
+        // and resets the sample and hold state. Should not be invoked during processing.
+        void prepare( int maxBlockSize );
+
+        // resets the sample and hold state
+        void reset();
+
+        // applies the crushing using the per-sample parameter values provided by ramps (when not nullptr)
+        void apply( float* channelData, unsigned long bufferSize, const ParameterRamps* ramps = nullptr );
+
+        // restarts the random sequence used for jitter and noise (equal seeds produce equal output)
+        void setSeed( uint32_t seed );
 
         void setAmount( float value );
         void setDownsampling( float value );
         void setLevel( float value );
 
+        // the oversampling factor of the signal, keeps the sample and hold duration constant in time
+        void setOversampling( int factor );
+
     private:
         float _bits; // amount scaled within 1 - 16 range
         float _mixLevel;
@@ -41,8 +58,33 @@ class BitCrusher
         float _crush;
         float _levels;
         int _downsampleBase;
+        int _oversampling = 1;
         float _jitterAmount;
         float _noiseAmount;
         int _sampleCounter = 0;
         float _lastSample = 0.0f;
+
+        // separate sequences for jitter and noise, so the output does not depend on the block size
+
+        RandomGenerator _jitterRandom;
+        RandomGenerator _noiseRandom;
+
+        // work buffers (of equal size) holding the crushed signal and the random values for the current block
+
+        std::vector<float> _crushed;
+        std::vector<float> _jitter;
+        std::vector<float> _noise;
+
+        void applyChunk( float* channelData, unsigned long bufferSize );
+        void applyRampedChunk( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps, size_t offset );
+
+        // the coefficients for provided (normalized) amount and downsampling, see setAmount() and setDownsampling()
+
+        static inline float getBits( float amount ) {
+            return juce::jmap( 1.f - amount, MIN_BITS, MAX_BITS );
+        }
+
+        inline int getDownsampleBase( float crush ) const {
+            return ( 1 + int( crush * crush * 80.0f )) * _oversampling;
+        }
 };
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Crossover.h"
+#include <algorithm>
+#include <cmath>
+
+/* public methods */
+
+void Crossover::prepare( double sampleRate, int numChannels, int maxBlockSize )
+{
+    _sampleRate = sampleRate;
+
+    const auto channels  = static_cast<size_t>( juce::jmax( 1, numChannels ));
+    const auto numGroups = ( channels + LANES - 1 ) / LANES;
+    const auto size      = static_cast<size_t>( juce::jmax( 1, maxBlockSize ));
+
+    _groups.resize( numGroups );
+    _allpasses.resize( channels );
+    _input.resize( size );
+    _lo.resize( size );
+
+    reset();
+}
+
+void Crossover::setNumBands( int numBands )
+{
+    numBands = juce::jlimit( 2, MAX_BANDS, numBands );
+
+    if ( numBands != _numBands ) {
+        _numBands = numBands;
+        reset();
+    }
+}
+
+void Crossover::setCutoffFrequency( int split, float frequency )
+{
+    // the prewarped cutoff tends to infinity at the Nyquist frequency (beyond which it turns negative and the split
+    // unstable), splits are kept below it (e.g. when the upper split frequencies exceed it at low sample rates)
+
+    const double cutoff = std::min( static_cast<double>( frequency ), _sampleRate * 0.45 );
+    const double g = std::tan( juce::MathConstants<double>::pi * cutoff / _sampleRate );
+    const double r = juce::MathConstants<double>::sqrt2; // the damping of a Butterworth section
+
+    auto& coefficients = _coefficients[ static_cast<size_t>( split )];
+
+    coefficients.g = static_cast<float>( g );
+    coefficients.h = static_cast<float>( 1.0 / ( 1.0 + r * g + g * g ));
+    coefficients.k = static_cast<float>( r + g );
+
+    // the sum of the bands of an LR4 split is a second order allpass (with a Q of 1 / sqrt( 2 )), as obtained by
+    // the bilinear transform (the numerator mirrors the denominator : b0 = a2, b1 = a1 and b2 = 1)
+
+    coefficients.a1 = static_cast<float>(( 2.0 * g * g - 2.0 ) * coefficients.h );
+    coefficients.a2 = static_cast<float>(( 1.0 - r * g + g * g ) * coefficients.h );
+}
+
+void Crossover::reset()
+{
+    for ( auto& group : _groups ) {
+        group.fill( SplitState {});
+    }
+    for ( auto& allpasses : _allpasses ) {
+        allpasses.fill( AllpassState {});
+    }
+}
+
+void Crossover::reset( int channel )
+{
+    const int lane = channel % LANES;
+
+    for ( auto& state : _groups[ static_cast<size_t>( channel / LANES )]) {
+        for ( auto* vector : { &state.shared1, &state.shared2, &state.lo1, &state.lo2, &state.hi1, &state.hi2 }) {
+            vector->lane[ lane ] = 0.f;
+        }
+    }
+    _allpasses[ static_cast<size_t>( channel )].fill( AllpassState {});
+}
+
+void Crossover::process( const float* const* input, float* const* bands, int numChannels, int numSamples )
+{
+    jassert( static_cast<size_t>( numSamples ) <= _input.size());
+
+    const auto size = std::min<size_t>( static_cast<size_t>( numSamples ), _input.size());
+
+    for ( size_t group = 0; group < _groups.size(); ++group )
+    {
+        const int firstChannel = static_cast<int>( group ) * LANES;
+        bool isActive = false;
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            const int channel = firstChannel + lane;
+            isActive = isActive || ( channel < numChannels && input[ channel ] != nullptr );
+        }
+
+        if ( !isActive ) {
+            continue;
+        }
+
+        // interleave the input of the group (skipped channels are processed as silence)
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            const int channel = firstChannel + lane;
+            const float* channelData = channel < numChannels ? input[ channel ] : nullptr;
+
+            if ( channelData == nullptr ) {
+                for ( size_t i = 0; i < size; ++i ) {
+                    _input[ i ].lane[ lane ] = 0.f;
+                }
+            } else {
+                for ( size_t i = 0; i < size; ++i ) {
+                    _input[ i ].lane[ lane ] = channelData[ i ];
+                }
+            }
+        }
+
+        // each split separates its low band from the remainder (which replaces the input of the next split)
+
+        for ( int split = 0; split < _numBands - 1; ++split ) {
+            processSplit( _coefficients[ static_cast<size_t>( split )], _groups[ group ][ static_cast<size_t>( split )], size );
+            writeBand( group, _lo, bands, split, input, numChannels, size );
+        }
+        writeBand( group, _input, bands, _numBands - 1, input, numChannels, size );
+    }
+}
+
+void Crossover::compensate( int channel, int split, float* channelData, int numSamples )
+{
+    const auto& coefficients = _coefficients[ static_cast<size_t>( split )];
+    auto& state = _allpasses[ static_cast<size_t>( channel )][ static_cast<size_t>( split )];
+
+    const float a1 = coefficients.a1;
+    const float a2 = coefficients.a2;
+
+    float z1 = state.z1;
+    float z2 = state.z2;
+
+    for ( int i = 0; i < numSamples; ++i ) {
+        const float x = channelData[ i ];
+        const float y = a2 * x + z1;
+
+        z1 = a1 * ( x - y ) + z2;
+        z2 = x - a2 * y;
+
+        channelData[ i ] = y;
+    }
+    state.z1 = z1;
+    state.z2 = z2;
+}
+
+/* private methods */
+
+void Crossover::processSplit( const Coefficients& coefficients, SplitState& state, size_t numSamples )
+{
+    // the state is copied locally so the compiler can keep it in registers
+
+    SplitState s = state;
+
+    const float g = coefficients.g;
+    const float h = coefficients.h;
+    const float k = coefficients.k;
+
+    for ( size_t i = 0; i < numSamples; ++i )
+    {
+        const Vector x = _input[ i ];
+        Vector lo;
+        Vector hi;
+
+        for ( int lane = 0; lane < LANES; ++lane )
+        {
+            // the shared section, yielding the low- and high-pass responses of the first stage
+
+            const float yH = ( x.lane[ lane ] - k * s.shared1.lane[ lane ] - s.shared2.lane[ lane ]) * h;
+            const float yB = g * yH + s.shared1.lane[ lane ];
+            s.shared1.lane[ lane ] = g * yH + yB;
+            const float yL = g * yB + s.shared2.lane[ lane ];
+            s.shared2.lane[ lane ] = g * yB + yL;
+
+            // the second low-pass section
+
+            const float lH = ( yL - k * s.lo1.lane[ lane ] - s.lo2.lane[ lane ]) * h;
+            const float lB = g * lH + s.lo1.lane[ lane ];
+            s.lo1.lane[ lane ] = g * lH + lB;
+            const float lL = g * lB + s.lo2.lane[ lane ];
+            s.lo2.lane[ lane ] = g * lB + lL;
+
+            // the second high-pass section
+
+            const float hH = ( yH - k * s.hi1.lane[ lane ] - s.hi2.lane[ lane ]) * h;
+            const float hB = g * hH + s.hi1.lane[ lane ];
+            s.hi1.lane[ lane ] = g * hH + hB;
+            s.hi2.lane[ lane ] = g * hB + ( g * hB + s.hi2.lane[ lane ]);
+
+            lo.lane[ lane ] = lL;
+            hi.lane[ lane ] = hH;
+        }
+        _lo[ i ]    = lo;
+        _input[ i ] = hi;
+    }
+    state = s;
+}
+
+void Crossover::writeBand( size_t group, const std::vector<Vector>& source, float* const* bands, int band,
+                           const float* const* input, int numChannels, size_t numSamples )
+{
+    for ( int lane = 0; lane < LANES; ++lane ) {
+        const int channel = static_cast<int>( group ) * LANES + lane;
+
+        if ( channel >= numChannels || input[ channel ] == nullptr ) {
+            continue;
+        }
+        float* channelData = bands[ channel * MAX_BANDS + band ];
+
+        for ( size_t i = 0; i < numSamples; ++i ) {
+            channelData[ i ] = source[ i ].lane[ lane ];
+        }
+    }
+}
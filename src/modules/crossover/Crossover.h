@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <vector>
+
+/**
+ * Linkwitz-Riley (LR4) crossover splitting the channels of a block into two to MAX_BANDS bands.
+ *
+ * Each split is the cascade of two second order Butterworth sections, implemented as topology-preserving
+ * state variable filters (like juce::dsp::LinkwitzRileyFilter). As the state variable filter computes the low- and
+ * high-pass responses at once, the first section of a split is shared by its low and high band (e.g. both bands
+ * are produced in a single pass). The splits form a tree : the first split separates the lowest band from the
+ * remainder, which is split again by the next split (and so on), so each additional band costs a single split.
+ *
+ * For two bands, the sum of the bands is an allpass response (magnitude-flat). For more bands, the lower bands miss
+ * the phase shift of the splits above them, which is compensated for when summing the (distorted) bands, see compensate().
+ *
+ * The channels are processed in groups of LANES side by side, allowing the compiler to process each group as a
+ * single SIMD vector. The coefficients are shared by all channels.
+ */
+class Crossover
+{
+    public:
+        static constexpr int LANES      = 4; // the amount of channels processed side by side
+        static constexpr int MAX_BANDS  = 5;
+        static constexpr int MAX_SPLITS = MAX_BANDS - 1;
+
+        // allocates the state for provided amount of channels and blocks of up to maxBlockSize samples (resets all state)
+        void prepare( double sampleRate, int numChannels, int maxBlockSize );
+
+        // the amount of bands (resets all state when changed)
+        void setNumBands( int numBands );
+        int getNumBands() const { return _numBands; }
+
+        // updates the coefficients of a split for all channels (e.g. once per block while the frequency is changing), the
+        // split at index n separates band n from band n + 1. The frequencies should be ascending in order of the splits,
+        // frequencies above 0.45 times the sample rate are clamped
+        void setCutoffFrequency( int split, float frequency );
+
+        void reset();
+        void reset( int channel );
+
+        /**
+         * Splits numSamples (up to maxBlockSize) of each channel into bands, where band n of a channel is written to
+         * bands[ channel * MAX_BANDS + n ]. Channels whose input is nullptr are skipped (their bands are left untouched),
+         * these should be silent and have their state reset (see reset( channel )), as their bands would be silent as well.
+         */
+        void process( const float* const* input, float* const* bands, int numChannels, int numSamples );
+
+        /**
+         * Applies the phase shift of provided split (an allpass, e.g. the sum of its low and high band) onto numSamples
+         * of provided channel. When summing the bands, each band is to be summed with the sum of the bands below
+         * it, after applying the phase shift of the split above that band (bands above the second to last split
+         * need no compensation), e.g. for four bands : sum = ap2( ap1( band0 ) + band1 ) + band2 + band3
+         * Can be invoked for different channels concurrently.
+         */
+        void compensate( int channel, int split, float* channelData, int numSamples );
+
+    private:
+        struct alignas( 16 ) Vector
+        {
+            float lane[ LANES ];
+        };
+
+        // the coefficients of the sections of a split and of its allpass (as a second order allpass in
+        // transposed direct form II, which has a shorter dependency chain than the state variable form)
+
+        struct Coefficients
+        {
+            float g = 0.f;
+            float h = 1.f;
+            float k = 0.f;
+            float a1 = 0.f;
+            float a2 = 1.f;
+        };
+
+        // the integrator states of the shared section and of the second section of each band of a split, for a group of channels
+
+        struct SplitState
+        {
+            Vector shared1;
+            Vector shared2;
+            Vector lo1;
+            Vector lo2;
+            Vector hi1;
+            Vector hi2;
+        };
+
+        // the state of an allpass compensating a channel
+
+        struct AllpassState
+        {
+            float z1 = 0.f;
+            float z2 = 0.f;
+        };
+
+        double _sampleRate = 44100.0;
+        int _numBands = 2;
+
+        std::array<Coefficients, MAX_SPLITS> _coefficients;
+        std::vector<std::array<SplitState, MAX_SPLITS>> _groups;
+        std::vector<std::array<AllpassState, MAX_SPLITS>> _allpasses;
+
+        std::vector<Vector> _input; // the input of a group (and the remainder of each split), interleaved
+        std::vector<Vector> _lo;    // the low band of a split, interleaved
+
+        void processSplit( const Coefficients& coefficients, SplitState& state, size_t numSamples );
+        void writeBand( size_t group, const std::vector<Vector>& source, float* const* bands, int band, const float* const* input, int numChannels, size_t numSamples );
+};
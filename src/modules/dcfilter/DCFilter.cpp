@@ -15,30 +15,183 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "DCFilter.h"
+#include <cmath>
 
-/* constructor */
+static constexpr double HIGH_PASS_FREQUENCY = 20.0;
+static constexpr double LOW_PASS_FREQUENCY  = 18000.0;
 
-DCFilter::DCFilter()
+/* public methods */
+
+void DCFilter::prepare( double sampleRate, int numChannels, int maxBlockSize )
 {
-    // nowt...
+    const auto channels  = static_cast<size_t>( juce::jmax( 1, numChannels ));
+    const auto numGroups = ( channels + LANES - 1 ) / LANES;
+
+    _groups.resize( numGroups );
+    _silence.assign( static_cast<size_t>( juce::jmax( 1, maxBlockSize )), 0.f );
+    _discard.resize( _silence.size());
+
+    // Butterworth sections as obtained by the bilinear transform (as by juce::dsp::IIR::Coefficients::makeLowPass()
+    // and makeHighPass()), where the low-pass frequency is kept below Nyquist at low sample rates
+
+    const double pi   = juce::MathConstants<double>::pi;
+    const double invQ = juce::MathConstants<double>::sqrt2;
+
+    const auto computeSection = [ sampleRate, pi, invQ ]( double frequency, bool isHighPass ) {
+        const double n  = 1.0 / std::tan( pi * frequency / sampleRate );
+        const double n2 = n * n;
+        const double c1 = 1.0 / ( 1.0 + invQ * n + n2 );
+
+        Biquad section;
+
+        section.b0 = static_cast<float>( isHighPass ? c1 * n2 : c1 );
+        section.b1 = static_cast<float>( isHighPass ? -2.0 * c1 * n2 : 2.0 * c1 );
+        section.b2 = section.b0;
+        section.a1 = static_cast<float>( 2.0 * c1 * ( 1.0 - n2 ));
+        section.a2 = static_cast<float>( c1 * ( 1.0 - invQ * n + n2 ));
+
+        return section;
+    };
+    _lowPass  = computeSection( std::min( LOW_PASS_FREQUENCY, sampleRate * 0.45 ), false );
+    _highPass = computeSection( HIGH_PASS_FREQUENCY, true );
+    _pole     = static_cast<float>( std::exp( -2.0 * pi * HIGH_PASS_FREQUENCY / sampleRate ));
+
+    reset();
 }
 
-/* public methods */
+bool DCFilter::hasUltrasonicRange( double sampleRate )
+{
+    return sampleRate * 0.5 > LOW_PASS_FREQUENCY;
+}
 
-void DCFilter::init( double sampleRate )
+void DCFilter::setMode( Mode mode )
 {
-    dcBlocker.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass( sampleRate, 20.0f );
-    postLPF.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass( sampleRate, 18000.0f );
+    if ( mode != _mode ) {
+        _mode = mode;
+        reset();
+    }
 }
 
-void DCFilter::apply( float* channelData, unsigned long bufferSize )
+void DCFilter::reset()
 {
-    for ( size_t i = 0; i < bufferSize; ++i )
+    std::fill( _groups.begin(), _groups.end(), State {});
+}
+
+void DCFilter::reset( int channel )
+{
+    const int lane = channel % LANES;
+    auto& state = _groups[ static_cast<size_t>( channel / LANES )];
+
+    for ( auto* vector : { &state.lpf1, &state.lpf2, &state.hpf1, &state.hpf2, &state.x1, &state.y1 }) {
+        vector->lane[ lane ] = 0.f;
+    }
+}
+
+void DCFilter::process( float* const* channels, int numChannels, int numSamples )
+{
+    jassert( static_cast<size_t>( numSamples ) <= _silence.size());
+
+    const auto size = std::min<size_t>( static_cast<size_t>( numSamples ), _silence.size());
+
+    for ( size_t group = 0; group < _groups.size(); ++group )
     {
-        float inputSample = channelData[ i ];
+        // the lanes of skipped channels read silence (and write into a scratch buffer)
+
+        Lanes lanes;
+        bool isActive = false;
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            const int channel  = static_cast<int>( group ) * LANES + lane;
+            float* channelData = channel < numChannels ? channels[ channel ] : nullptr;
+
+            isActive = isActive || channelData != nullptr;
+
+            lanes.input[ lane ]  = channelData != nullptr ? channelData : _silence.data();
+            lanes.output[ lane ] = channelData != nullptr ? channelData : _discard.data();
+        }
+
+        if ( !isActive ) {
+            continue;
+        }
 
-        channelData[ i ] = dcBlocker.processSample(
-            postLPF.processSample( inputSample )
-        );
+        if ( _mode == Mode::DCBlock ) {
+            processOnePole( _groups[ group ], lanes, size );
+        } else {
+            processBiquads( _groups[ group ], lanes, size );
+        }
     }
-}
\ No newline at end of file
+}
+
+/* private methods */
+
+void DCFilter::processBiquads( State& state, const Lanes& channels, size_t numSamples )
+{
+    // the state and the channel pointers are copied locally so the compiler can keep them in registers
+
+    State s = state;
+    const Lanes lanes = channels;
+
+    const Biquad lp = _lowPass;
+    const Biquad hp = _highPass;
+
+    for ( size_t i = 0; i < numSamples; ++i )
+    {
+        Vector v;
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            v.lane[ lane ] = lanes.input[ lane ][ i ];
+        }
+
+        for ( int lane = 0; lane < LANES; ++lane )
+        {
+            const float x = v.lane[ lane ];
+            const float l = lp.b0 * x + s.lpf1.lane[ lane ];
+
+            s.lpf1.lane[ lane ] = lp.b1 * x - lp.a1 * l + s.lpf2.lane[ lane ];
+            s.lpf2.lane[ lane ] = lp.b2 * x - lp.a2 * l;
+
+            const float h = hp.b0 * l + s.hpf1.lane[ lane ];
+
+            s.hpf1.lane[ lane ] = hp.b1 * l - hp.a1 * h + s.hpf2.lane[ lane ];
+            s.hpf2.lane[ lane ] = hp.b2 * l - hp.a2 * h;
+
+            v.lane[ lane ] = h;
+        }
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            lanes.output[ lane ][ i ] = v.lane[ lane ];
+        }
+    }
+    state = s;
+}
+
+void DCFilter::processOnePole( State& state, const Lanes& channels, size_t numSamples )
+{
+    // y[ n ] = x[ n ] - x[ n - 1 ] + pole * y[ n - 1 ]
+
+    Vector x1 = state.x1;
+    Vector y1 = state.y1;
+    const Lanes lanes = channels;
+
+    const float pole = _pole;
+
+    for ( size_t i = 0; i < numSamples; ++i )
+    {
+        Vector x;
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            x.lane[ lane ] = lanes.input[ lane ][ i ];
+        }
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            y1.lane[ lane ] = x.lane[ lane ] - x1.lane[ lane ] + pole * y1.lane[ lane ];
+        }
+        x1 = x;
+
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            lanes.output[ lane ][ i ] = y1.lane[ lane ];
+        }
+    }
+    state.x1 = x1;
+    state.y1 = y1;
+}
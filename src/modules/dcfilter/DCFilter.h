@@ -16,22 +16,95 @@
  */
 #pragma once
 
-#include <juce_audio_processors/juce_audio_processors.h>
-#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+#include <vector>
 
 /**
- * Filter utility to remove both ultrasonic and infrasonic
- * noise from a signal.
+ * Filter utility to remove both ultrasonic and infrasonic noise from a signal.
+ *
+ * In Mode::DCBlockAndLowPass the signal passes a second order low-pass at 18 kHz followed by a second order
+ * high-pass at 20 Hz (both Butterworth, with the coefficients of juce::dsp::IIR::Coefficients), in transposed
+ * direct form II. When the ultrasonic content needs no removal, Mode::DCBlock only applies a one-pole DC blocker
+ * (a differentiator followed by a leaky integrator) which costs a fraction of the biquads.
+ *
+ * The channels are processed in groups of LANES side by side (like the Crossover), allowing the
+ * compiler to process each group as a single SIMD vector. The coefficients are shared by all channels.
  */
 class DCFilter
 {
     public:
-        DCFilter();
+        static constexpr int LANES = 4; // the amount of channels processed side by side
+
+        enum class Mode {
+            DCBlockAndLowPass,
+            DCBlock
+        };
+
+        // allocates the state for provided amount of channels and blocks of up to maxBlockSize samples (resets all state)
+        void prepare( double sampleRate, int numChannels, int maxBlockSize );
 
-        void init( double sampleRate );
-        void apply( float* channelData, unsigned long bufferSize );
+        // whether the Nyquist frequency of provided sample rate lies above the cutoff of the low-pass, e.g. whether
+        // the range between them holds content that only Mode::DCBlockAndLowPass removes
+        static bool hasUltrasonicRange( double sampleRate );
+
+        // resets all state when changed
+        void setMode( Mode mode );
+        Mode getMode() const { return _mode; }
+
+        void reset();
+        void reset( int channel );
+
+        /**
+         * Filters numSamples (up to maxBlockSize) of each channel in place. Channels that are nullptr are skipped,
+         * these should be silent and have their state reset (see reset( channel )).
+         */
+        void process( float* const* channels, int numChannels, int numSamples );
 
     private:
-        juce::dsp::IIR::Filter<float> dcBlocker;
-        juce::dsp::IIR::Filter<float> postLPF;
+        struct alignas( 16 ) Vector
+        {
+            float lane[ LANES ];
+        };
+
+        // a second order section in transposed direct form II (normalized, e.g. a0 = 1)
+
+        struct Biquad
+        {
+            float b0 = 1.f;
+            float b1 = 0.f;
+            float b2 = 0.f;
+            float a1 = 0.f;
+            float a2 = 0.f;
+        };
+
+        struct State
+        {
+            Vector lpf1;
+            Vector lpf2;
+            Vector hpf1;
+            Vector hpf2;
+            Vector x1; // the previous input of the one-pole DC blocker
+            Vector y1; // the previous output of the one-pole DC blocker
+        };
+
+        Mode _mode = Mode::DCBlockAndLowPass;
+
+        Biquad _lowPass;
+        Biquad _highPass;
+        float _pole = 0.f; // of the one-pole DC blocker
+
+        // the channels of a group, read and written in place
+
+        struct Lanes
+        {
+            const float* input[ LANES ];
+            float* output[ LANES ];
+        };
+
+        std::vector<State> _groups;
+        std::vector<float> _silence; // read by the lanes of skipped channels
+        std::vector<float> _discard; // written by the lanes of skipped channels
+
+        void processBiquads( State& state, const Lanes& lanes, size_t numSamples );
+        void processOnePole( State& state, const Lanes& lanes, size_t numSamples );
 };
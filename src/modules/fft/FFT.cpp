@@ -20,100 +20,149 @@
 
 FFT::FFT()
 {
-    fftTime.resize(( size_t ) Parameters::FFT::DOUBLE_SIZE );
-    window.resize( Parameters::FFT::SIZE );
+    // nowt...
+}
+
+FFT::~FFT()
+{
+    // nowt...
+}
+
+/* public methods */
+
+void FFT::prepare( double sampleRate, int numWorkspaces )
+{
+    _sampleRate = sampleRate;
+    harmonicMask.setFFTSize( _size, _sampleRate ); // bin frequencies have changed
+
+    const size_t workspaceAmount = static_cast<size_t>( juce::jmax( 1, numWorkspaces ));
 
-    for ( size_t n = 0; n < Parameters::FFT::SIZE; ++n ) {
-        window[ n ] = 0.5f - 0.5f * std::cos( 2.f * juce::MathConstants<float>::pi * n / Parameters::FFT::SIZE );
+    if ( workspaces.size() != workspaceAmount ) {
+        workspaces.resize( workspaceAmount );
+
+        for ( auto& workspace : workspaces ) {
+            workspace.fftTime.resize(( size_t ) Parameters::FFT::MAX_DOUBLE_SIZE );
+            workspace.packedSpectrum.resize( Parameters::FFT::MAX_SIZE );
+            workspace.packedTime.resize( Parameters::FFT::MAX_SIZE );
+        }
     }
 
-    harmonics.reserve(( size_t ) Parameters::Ranges::HARMONIC_COUNT );
-    harmonicMask.reserve(( size_t ) Parameters::FFT::HOP_SIZE );
+    if ( plans[ 0 ].fft != nullptr ) {
+        return; // already allocated
+    }
 
-    _fft = new juce::dsp::FFT( Parameters::FFT::ORDER );
+    for ( int order = Parameters::FFT::MIN_ORDER; order <= Parameters::FFT::MAX_ORDER; ++order ) {
+        auto& plan = plans[ static_cast<size_t>( order - Parameters::FFT::MIN_ORDER )];
+
+        plan.fft = std::make_unique<juce::dsp::FFT>( order );
+        createWindows( plan, 1 << order );
+    }
+    configure( Parameters::FFT::DEFAULT_ORDER, _overlap );
 }
 
-FFT::~FFT()
+bool FFT::configure( int order, int overlap )
+{
+    order   = juce::jlimit( Parameters::FFT::MIN_ORDER, Parameters::FFT::MAX_ORDER, order );
+    overlap = overlap >= 4 ? 4 : 2;
+
+    auto* plan = &plans[ static_cast<size_t>( order - Parameters::FFT::MIN_ORDER )];
+
+    if ( plan == _plan && overlap == _overlap ) {
+        return false;
+    }
+    const size_t windowIndex = overlap == 4 ? 1 : 0;
+
+    _plan    = plan;
+    _size    = 1 << order;
+    _overlap = overlap;
+    _analysisWindow  = plan->analysisWindow[ windowIndex ].data();
+    _synthesisWindow = plan->synthesisWindow[ windowIndex ].data();
+    _spectrumScale   = plan->spectrumScale[ windowIndex ];
+    harmonicMask.setFFTSize( _size, _sampleRate ); // mask must be rebuilt for the new bin spacing
+
+    return true;
+}
+
+int FFT::getAutomaticOrder( double sampleRate )
 {
-    delete _fft;
+    const int order = Parameters::FFT::DEFAULT_ORDER + juce::roundToInt( std::log2( sampleRate / Parameters::FFT::REFERENCE_SAMPLE_RATE ));
+    return juce::jlimit( Parameters::FFT::MIN_ORDER, Parameters::FFT::MAX_ORDER, order );
 }
 
-/* public methods */
+void FFT::setHarmonics( float frequency, int count, float width, float falloff )
+{
+    harmonicMask.setHarmonics( frequency, count, width, falloff );
+}
 
-void FFT::update( double sampleRate )
+void FFT::setSynchronous( bool synchronous )
 {
-    _sampleRate = ( float ) sampleRate;
-    _nyquist = ( float ) _sampleRate * 0.5f;
+    harmonicMask.setSynchronous( synchronous );
 }
 
-void FFT::calculateHarmonics( float frequency )
+void FFT::update()
 {
-    if ( juce::approximatelyEqual( frequency, _lastFreq )) {
-        return; // no need to recalculate
-    }
-    harmonics.clear();
-    
-    for ( size_t h = 1; h <= Parameters::Ranges::HARMONIC_COUNT; ++h )
-    {
-        float freq = h * frequency;
-        if ( freq >= _nyquist ) {
-            break;
-        }
-        Harmonic harm;
-        harm.freq = freq;
-        harm.widthHz = freq * Parameters::Ranges::HARMONIC_WIDTH;
-        harm.weight = 1.0f / std::pow(( float ) h, Parameters::Ranges::HARMONIC_FALLOFF ); 
-        harmonics.push_back( harm );
-    }
+    _mask = harmonicMask.acquire();
+}
 
-    // calculate harmonic mask
+void FFT::split( const float* inputRing, size_t offset, std::vector<float>& specA, std::vector<float>& specB, size_t workspace )
+{
+    auto& fftTime        = workspaces[ workspace ].fftTime;
+    auto& packedSpectrum = workspaces[ workspace ].packedSpectrum;
+    auto& packedTime     = workspaces[ workspace ].packedTime;
 
-    for ( size_t bin = 0; bin < Parameters::FFT::HOP_SIZE; ++bin )
-    {
-        float binFreq = ( float ) bin * ( float ) _sampleRate / ( float ) Parameters::FFT::SIZE;
-        float maskA = 0.0f;
+    transformFrame( inputRing, offset, fftTime );
 
-        for ( Harmonic harmonic : harmonics )
-        {
-            float distance = std::abs( binFreq - harmonic.freq );
-            float norm = distance / harmonic.widthHz;
+    // split spectrum by harmonic proximity (including the DC and Nyquist bins), where the masked spectra
+    // are packed as Z = A + iB. As the masks are real, Z[ k ] = X[ k ] * ( maskA + i * maskB ) for the positive
+    // frequencies and Z[ N - k ] = conj( X[ k ]) * ( maskA + i * maskB ) for the negative frequencies
 
-            if ( norm < 1.0f )
-            {
-                // option A (soft triangular mask)
-                float contribution = harmonic.weight * ( 1.0f - norm );
+    const auto* spectrum = reinterpret_cast<const juce::dsp::Complex<float>*>( fftTime.data());
+    const size_t size    = static_cast<size_t>( _size );
+    const size_t numBins = size / 2;
 
-                // option B (smoother mask curve for less ringing)
-                // float t = 1.0f - norm;
-                // float smooth = t * t * (3.0f - 2.0f * t);
-                // float contribution = harmonic.weight * smooth;
+    auto pack = [ &packedSpectrum, spectrum, size, numBins ]( size_t bin, float maskA ) {
+        const juce::dsp::Complex<float> masks( maskA, 1.0f - maskA );
 
-                maskA = std::max( maskA, contribution );
-            }
+        packedSpectrum[ bin ] = spectrum[ bin ] * masks;
+
+        if ( bin > 0 && bin < numBins ) {
+            packedSpectrum[ size - bin ] = std::conj( spectrum[ bin ]) * masks;
+        }
+    };
+
+    // all bins are unrelated (maskA = 0) except for those listed in the sparse harmonic mask
+
+    for ( size_t bin = 0; bin <= numBins; ++bin ) {
+        pack( bin, 0.0f );
+    }
+    if ( _mask != nullptr ) {
+        for ( const auto& entry : _mask->entries ) {
+            pack( entry.bin, entry.weight );
         }
-        harmonicMask[ bin ] = juce::jlimit( 0.0f, 1.0f, maskA );
     }
-    _lastFreq = frequency;
-}
 
-void FFT::split( const std::vector<float>& inputBuffer, std::vector<float>& specA, std::vector<float>& specB ) {
+    // apply a single inverse transform and unpack
 
-    // apply window to overcome spectral leakage
+    _plan->fft->perform( packedSpectrum.data(), packedTime.data(), true );
 
-    for ( size_t i = 0; i < Parameters::FFT::SIZE; ++i ) {
-        fftTime[ i ] = inputBuffer[ i ] * window[ i ];
+    for ( size_t i = 0; i < size; ++i ) {
+        specA[ i ] = packedTime[ i ].real();
+        specB[ i ] = packedTime[ i ].imag();
     }
+}
 
-    // apply forward transform
+void FFT::splitSeparate( const float* inputRing, size_t offset, std::vector<float>& specA, std::vector<float>& specB, size_t workspace )
+{
+    auto& fftTime = workspaces[ workspace ].fftTime;
 
-    _fft->performRealOnlyForwardTransform( fftTime.data() );
+    transformFrame( inputRing, offset, fftTime );
 
-    // split spectrum by harmonic proximity
+    // split spectrum by harmonic proximity (including the DC and Nyquist bins)
 
-    for ( size_t bin = 1; bin < Parameters::FFT::HOP_SIZE; ++bin )
-    {
-        float maskA = harmonicMask[ bin ];
-        float maskB = 1.0f - maskA;
+    const size_t numBins = static_cast<size_t>( _size / 2 );
+
+    auto apply = [ &fftTime, &specA, &specB ]( size_t bin, float maskA ) {
+        const float maskB = 1.0f - maskA;
 
         size_t realIndex = 2 * bin;
         size_t imagIndex = 2 * bin + 1;
@@ -126,17 +175,103 @@ void FFT::split( const std::vector<float>& inputBuffer, std::vector<float>& spec
 
         specB[ realIndex ] = real * maskB;
         specB[ imagIndex ] = imag * maskB;
+    };
+
+    for ( size_t bin = 0; bin <= numBins; ++bin ) {
+        apply( bin, 0.0f );
+    }
+    if ( _mask != nullptr ) {
+        for ( const auto& entry : _mask->entries ) {
+            apply( entry.bin, entry.weight );
+        }
+    }
+
+    // apply inverse transforms
+
+    _plan->fft->performRealOnlyInverseTransform( specA.data() );
+    _plan->fft->performRealOnlyInverseTransform( specB.data() );
+}
+
+void FFT::sum( float* outputRing, size_t offset, const std::vector<float>& specA, const std::vector<float>& specB )
+{
+    const size_t size      = static_cast<size_t>( _size );
+    const size_t wrapIndex = size - offset;
+
+    for ( size_t i = 0; i < wrapIndex; ++i ) {
+        outputRing[ offset + i ] += ( specA[ i ] + specB[ i ]) * _synthesisWindow[ i ];
+    }
+    for ( size_t i = wrapIndex; i < size; ++i ) {
+        outputRing[ i - wrapIndex ] += ( specA[ i ] + specB[ i ]) * _synthesisWindow[ i ];
+    }
+}
+
+/* private methods */
+
+void FFT::transformFrame( const float* inputRing, size_t offset, std::vector<float>& fftTime )
+{
+    // unwrap the frame from the ring buffer (oldest sample first) while applying
+    // the window to overcome spectral leakage
+
+    const size_t size      = static_cast<size_t>( _size );
+    const size_t wrapIndex = size - offset;
+
+    for ( size_t i = 0; i < wrapIndex; ++i ) {
+        fftTime[ i ] = inputRing[ offset + i ] * _analysisWindow[ i ];
+    }
+    for ( size_t i = wrapIndex; i < size; ++i ) {
+        fftTime[ i ] = inputRing[ i - wrapIndex ] * _analysisWindow[ i ];
     }
 
-    // apply inverse transform
+    // apply forward transform (of which the result are the complex bins 0 to N / 2, interleaved)
 
-    _fft->performRealOnlyInverseTransform( specA.data() );
-    _fft->performRealOnlyInverseTransform( specB.data() );
+    _plan->fft->performRealOnlyForwardTransform( fftTime.data(), true );
 }
 
-void FFT::sum( std::vector<float>& outputBuffer, std::vector<float>& specA, std::vector<float>& specB )
+void FFT::createWindows( Plan& plan, int size )
 {
-    for ( size_t i = 0; i < Parameters::FFT::SIZE; ++i ) {
-        outputBuffer[ i ] += ( specA[ i ] + specB[ i ]) * window[ i ];
+    const auto windowSize = static_cast<size_t>( size );
+
+    for ( size_t windowIndex = 0; windowIndex < 2; ++windowIndex )
+    {
+        const int overlap = windowIndex == 0 ? 2 : 4;
+        const int hopSize = size / overlap;
+
+        auto& analysis  = plan.analysisWindow[ windowIndex ];
+        auto& synthesis = plan.synthesisWindow[ windowIndex ];
+
+        analysis.resize( windowSize );
+        synthesis.resize( windowSize );
+
+        // at 2x overlap a square root Hann window is applied both before and after processing, at 4x overlap a
+        // Hann window is applied both times. In either case the product of the windows sums to a constant when
+        // overlapped by the hop size (a periodic window is used, so the frames tile exactly)
+
+        for ( size_t n = 0; n < windowSize; ++n ) {
+            const double hann = 0.5 - 0.5 * std::cos( 2.0 * juce::MathConstants<double>::pi * ( double ) n / ( double ) size );
+            analysis[ n ] = ( float )( overlap == 2 ? std::sqrt( hann ) : hann );
+        }
+        std::copy( analysis.begin(), analysis.end(), synthesis.begin());
+
+        double windowSum = 0.0;
+        for ( const float value : analysis ) {
+            windowSum += value;
+        }
+        plan.spectrumScale[ windowIndex ] = ( float )( 2.0 / windowSum );
+
+        // determine the overlapped sum to normalise the synthesis window to unity gain
+
+        double overlappedSum = 0.0;
+
+        for ( int n = 0; n < hopSize; ++n ) {
+            for ( int frame = 0; frame < overlap; ++frame ) {
+                const auto index = static_cast<size_t>( n + frame * hopSize );
+                overlappedSum += ( double ) analysis[ index ] * ( double ) synthesis[ index ];
+            }
+        }
+        const float normalisation = ( float )( hopSize / overlappedSum );
+
+        for ( auto& value : synthesis ) {
+            value *= normalisation;
+        }
     }
 }
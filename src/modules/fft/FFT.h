@@ -19,33 +19,108 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "../../Parameters.h"
+#include "HarmonicMask.h"
 
 class FFT
 {
     public:
         FFT();
         ~FFT();
-        
-        void update( double sampleRate );
-        void calculateHarmonics( float frequency );
-        void split( const std::vector<float>& inputBuffer, std::vector<float>& specA, std::vector<float>& specB );
-        void sum( std::vector<float>& outputBuffer, std::vector<float>& specA, std::vector<float>& specB );
-        
+
+        // allocates the transforms, windows and buffers for all supported sizes (allocation happens only on first
+        // invocation or when the amount of workspaces changes) and applies the sample rate. A workspace holds the
+        // working buffers of a split, split() can run concurrently on different workspaces (e.g. one per thread).
+        // Should not be invoked during processing.
+        void prepare( double sampleRate, int numWorkspaces = 1 );
+
+        /**
+         * Selects the FFT order (Parameters::FFT::MIN_ORDER - MAX_ORDER) and overlap (2 or 4 frames),
+         * does not allocate and is thus safe to invoke during processing. Returns true when the configuration
+         * changed, in which case previously processed frames are no longer compatible.
+         */
+        bool configure( int order, int overlap );
+
+        int getSize() const { return _size; }
+        int getHopSize() const { return _size / _overlap; }
+
+        // the order that keeps the bin spacing close to that of the default order at the reference sample rate
+        static int getAutomaticOrder( double sampleRate );
+
+        // see HarmonicMask::setHarmonics()
+        void setHarmonics( float frequency, int count, float width, float falloff );
+
+        // whether harmonic masks are built on the calling thread (e.g. for deterministic offline rendering)
+        void setSynchronous( bool synchronous );
+
+        // picks up the most recent harmonic mask, to be invoked by the audio thread once per block (before splitting)
+        void update();
+
+        /**
+         * Splits a frame of getSize() samples into specA (harmonically related content) and specB (remainder), both
+         * yielding getSize() time domain samples. The frame is read from ring buffer inputRing (of getSize() samples)
+         * where offset is the index of the oldest sample.
+         */
+        void split( const float* inputRing, size_t offset, std::vector<float>& specA, std::vector<float>& specB, size_t workspace = 0 );
+
+        /**
+         * Equal to split() though computing the inverse transforms of specA and specB separately
+         * (twice the cost), kept as a reference for verifying the output of split()
+         */
+        void splitSeparate( const float* inputRing, size_t offset, std::vector<float>& specA, std::vector<float>& specB, size_t workspace = 0 );
+
+        // the spectrum of the last frame split on provided workspace (the interleaved complex bins 0 to getSize() / 2)
+        const float* getSpectrum( size_t workspace = 0 ) const { return workspaces[ workspace ].fftTime.data(); }
+
+        // the harmonic mask applied by split() (can be nullptr) and the scale normalising the magnitudes
+        // of the spectrum (where a full scale sine has a magnitude of 1)
+        const HarmonicMask::Mask* getMask() const { return _mask; }
+        float getSpectrumScale() const { return _spectrumScale; }
+
+        /**
+         * Windows the sum of specA and specB and overlap-adds the result onto ring buffer outputRing
+         * (of getSize() samples) starting at offset (e.g. the same offset the frame was split at)
+         */
+        void sum( float* outputRing, size_t offset, const std::vector<float>& specA, const std::vector<float>& specB );
+
     private:
-        juce::dsp::FFT* _fft;
-        std::vector<float> fftTime;
-        std::vector<float> window;
+        static constexpr int NUM_ORDERS = Parameters::FFT::MAX_ORDER - Parameters::FFT::MIN_ORDER + 1;
+
+        // the transform and window pairs for a single FFT order, per overlap (index 0 = 2x, index 1 = 4x)
 
-        struct Harmonic
+        struct Plan
         {
-            float freq;
-            float widthHz;
-            float weight;
+            std::unique_ptr<juce::dsp::FFT> fft;
+            std::vector<float> analysisWindow[ 2 ];
+            std::vector<float> synthesisWindow[ 2 ];
+            float spectrumScale[ 2 ]; // two over the sum of the analysis window
         };
+        std::array<Plan, NUM_ORDERS> plans;
+
+        // currently active configuration
+
+        Plan* _plan = nullptr;
+        const float* _analysisWindow  = nullptr;
+        const float* _synthesisWindow = nullptr;
+        float _spectrumScale = 1.f;
+        int _size    = 1 << Parameters::FFT::DEFAULT_ORDER;
+        int _overlap = 2;
+
+        struct Workspace
+        {
+            std::vector<float> fftTime;
+
+            // both masked spectra are real signals in the time domain, as such they can be packed into
+            // a single complex spectrum ( A + iB ) of which the inverse holds A in its real and B in its imaginary part
+
+            std::vector<juce::dsp::Complex<float>> packedSpectrum;
+            std::vector<juce::dsp::Complex<float>> packedTime;
+        };
+        std::vector<Workspace> workspaces;
+
+        void transformFrame( const float* inputRing, size_t offset, std::vector<float>& fftTime );
+        static void createWindows( Plan& plan, int size );
 
-        std::vector<Harmonic> harmonics;
-        std::vector<float> harmonicMask;
-        float _sampleRate = 44100.f;
-        float _nyquist = 22050.f;
-        float _lastFreq = 0.f;
-};
\ No newline at end of file
+        HarmonicMask harmonicMask;
+        const HarmonicMask::Mask* _mask = nullptr; // the mask acquired on the last update()
+        double _sampleRate = 44100.0;
+};
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "HarmonicMask.h"
+
+// interval (in milliseconds) at which the builder thread checks for stale masks when idle
+
+static constexpr int IDLE_INTERVAL = 10;
+
+/* constructor / destructor */
+
+HarmonicMask::HarmonicMask()
+{
+    // allocate for the worst case (all bins of the largest FFT are harmonically related), so
+    // building a mask never allocates
+
+    const size_t maxBins = Parameters::FFT::MAX_SIZE / 2 + 1;
+
+    masks.forEachBuffer([ maxBins ]( Mask& mask ) {
+        mask.entries.reserve( maxBins );
+    });
+    weights.resize( maxBins, 0.f );
+
+    builder->addTimeSliceClient( this );
+}
+
+HarmonicMask::~HarmonicMask()
+{
+    builder->removeTimeSliceClient( this );
+}
+
+/* public methods */
+
+void HarmonicMask::setSynchronous( bool value )
+{
+    synchronous.store( value );
+}
+
+void HarmonicMask::setFFTSize( int fftSize, double sampleRate )
+{
+    request( _fftSize, fftSize );
+    request( _sampleRate, sampleRate );
+}
+
+void HarmonicMask::setHarmonics( float frequency, int count, float width, float falloff )
+{
+    request( _frequency, frequency );
+    request( _count, count );
+    request( _width, width );
+    request( _falloff, falloff );
+}
+
+const HarmonicMask::Mask* HarmonicMask::acquire()
+{
+    if ( synchronous.load( std::memory_order_relaxed ) &&
+         builtVersion.load( std::memory_order_relaxed ) != requestedVersion.load( std::memory_order_acquire )) {
+        build();
+    }
+    masks.update();
+
+    const auto& mask = masks.getReadBuffer();
+
+    // a mask built for a different FFT size lists bins of a different frequency
+
+    return mask.fftSize == _fftSize.load( std::memory_order_relaxed ) ? &mask : nullptr;
+}
+
+/* private methods */
+
+bool HarmonicMask::build()
+{
+    // only one thread can produce a mask at a time (when switching between
+    // synchronous and asynchronous building, both threads could attempt to do so)
+
+    if ( building.exchange( true, std::memory_order_acquire )) {
+        return false;
+    }
+
+    // the version is read before building : when a parameter changes while building, the
+    // mask is published under an outdated version and rebuilt on the next attempt
+
+    const juce::uint32 version = requestedVersion.load( std::memory_order_acquire );
+
+    const int   fftSize   = _fftSize.load();
+    const float frequency = _frequency.load();
+    const int   count     = _count.load();
+    const float width     = _width.load();
+    const float falloff   = _falloff.load();
+
+    const float sampleRate = static_cast<float>( _sampleRate.load());
+    const float nyquist    = sampleRate * 0.5f;
+    const float binWidthHz = sampleRate / static_cast<float>( juce::jmax( 1, fftSize ));
+    const int numBins      = fftSize / 2 + 1;
+
+    auto& mask = masks.getWriteBuffer();
+    mask.entries.clear();
+
+    // accumulate the (soft triangular) contribution of each harmonic, only visiting the bins within its width
+
+    int firstBin = numBins;
+    int lastBin  = -1;
+
+    for ( int h = 1; h <= count && frequency > 0.f && fftSize > 0; ++h )
+    {
+        const float freq = static_cast<float>( h ) * frequency;
+        if ( freq >= nyquist ) {
+            break;
+        }
+        const float widthHz = freq * width;
+        const float weight  = 1.0f / std::pow( static_cast<float>( h ), falloff );
+
+        const int lowBin  = juce::jmax( 0, static_cast<int>( std::ceil(( freq - widthHz ) / binWidthHz )));
+        const int highBin = juce::jmin( numBins - 1, static_cast<int>( std::floor(( freq + widthHz ) / binWidthHz )));
+
+        for ( int bin = lowBin; bin <= highBin; ++bin )
+        {
+            const float norm = std::abs( static_cast<float>( bin ) * binWidthHz - freq ) / widthHz;
+
+            if ( norm < 1.0f ) {
+                auto& binWeight = weights[ static_cast<size_t>( bin )];
+                binWeight = std::max( binWeight, weight * ( 1.0f - norm ));
+            }
+        }
+        firstBin = juce::jmin( firstBin, lowBin );
+        lastBin  = juce::jmax( lastBin,  highBin );
+    }
+
+    // collect the weighted bins (and clear the work buffer for the next build)
+
+    for ( int bin = firstBin; bin <= lastBin; ++bin )
+    {
+        auto& binWeight = weights[ static_cast<size_t>( bin )];
+
+        if ( binWeight > 0.f ) {
+            mask.entries.push_back({ static_cast<juce::uint32>( bin ), juce::jmin( 1.0f, binWeight )});
+        }
+        binWeight = 0.f;
+    }
+    mask.fftSize = fftSize;
+    mask.version = version;
+
+    masks.publish();
+    builtVersion.store( version, std::memory_order_relaxed );
+
+    building.store( false, std::memory_order_release );
+
+    return true;
+}
+
+int HarmonicMask::useTimeSlice()
+{
+    const bool isStale = builtVersion.load( std::memory_order_relaxed ) != requestedVersion.load( std::memory_order_relaxed );
+
+    if ( isStale && !synchronous.load()) {
+        build();
+        return 1; // check again shortly in case parameters are still changing
+    }
+    return IDLE_INTERVAL;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "../../Parameters.h"
+#include "../../utils/BackgroundThread.h"
+#include "../../utils/TripleBuffer.h"
+
+/**
+ * The weights of the FFT bins that are harmonically related to a base frequency, in a sparse
+ * representation (only the bins near the harmonics are listed, all other bins have a weight of 0).
+ *
+ * Changes to the harmonic parameters only request a new mask, the mask is built on the shared
+ * BackgroundThread and published to the audio thread without locking. Until the new mask is available,
+ * the previous mask is used. When synchronous, masks are built on the audio thread instead (as offline
+ * rendering should be deterministic).
+ */
+class HarmonicMask : private juce::TimeSliceClient
+{
+    public:
+        struct Entry
+        {
+            juce::uint32 bin;
+            float weight; // within the 0 - 1 range (exclusive of 0)
+        };
+
+        struct Mask
+        {
+            std::vector<Entry> entries; // in ascending bin order
+            int fftSize = 0;            // the FFT size the bins apply to
+            juce::uint32 version = 0;
+        };
+
+        HarmonicMask();
+        ~HarmonicMask() override;
+
+        void setSynchronous( bool synchronous );
+
+        // to be invoked when the FFT size or sample rate change
+        void setFFTSize( int fftSize, double sampleRate );
+
+        /**
+         * Requests a mask for provided base frequency (in Hz), amount of harmonics, width (relative to
+         * each harmonics frequency) and falloff (0 = equal weights, 1 = natural harmonic spread, 2 = emphasis
+         * on lower harmonics). Cheap (only requests a rebuild when the values changed) and safe to invoke from
+         * the audio thread.
+         */
+        void setHarmonics( float frequency, int count, float width, float falloff );
+
+        // to be invoked by the audio thread, returns the most recent mask matching the current FFT size
+        // (can be stale) or nullptr when none has been built for the current FFT size yet
+        const Mask* acquire();
+
+    private:
+        // the requested parameters (written by the audio thread, read by the builder)
+
+        std::atomic<float> _frequency { 0.f };
+        std::atomic<int>   _count     { 0 };
+        std::atomic<float> _width     { 0.f };
+        std::atomic<float> _falloff   { 0.f };
+        std::atomic<int>   _fftSize   { 0 };
+        std::atomic<double> _sampleRate { 44100.0 };
+
+        TripleBuffer<Mask> masks;
+        std::vector<float> weights; // dense work buffer used while building a mask
+        juce::SharedResourcePointer<BackgroundThread> builder;
+
+        std::atomic<juce::uint32> requestedVersion { 1 };
+        std::atomic<juce::uint32> builtVersion { 0 };
+        std::atomic<bool> building { false }; // guards the producer side of the masks
+        std::atomic<bool> synchronous { false };
+
+        template <typename T>
+        void request( std::atomic<T>& property, T value ) {
+            if ( property.exchange( value ) != value ) {
+                requestedVersion.fetch_add( 1, std::memory_order_release );
+            }
+        }
+
+        bool build();
+        int useTimeSlice() override;
+};
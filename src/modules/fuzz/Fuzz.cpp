@@ -19,7 +19,7 @@
 
 // constructor
 
-Fuzz::Fuzz()
+Fuzz::Fuzz() : _table([ this ]( float* table, int numPoints ) { renderTable( table, numPoints ); })
 {
     setInputLevel( Parameters::Config::DIST_INPUT_DEF );
     setCutOff( Parameters::Config::DIST_PARAM_DEF );
@@ -31,18 +31,26 @@ Fuzz::Fuzz()
 
 void Fuzz::apply( float* channelData, unsigned long bufferSize )
 {
+    if ( const float* table = _table.acquire()) {
+        applyTable( table, channelData, bufferSize );
+        return;
+    }
+
+    const float squareWaveThreshold = _squareWaveThreshold.load();
+    const float cutoffThreshold     = _cutoffThreshold.load();
+
     for ( size_t i = 0; i < bufferSize; ++i )
     {
         float inputSample  = channelData[ i ] * _input;
         float outputSample = inputSample * _drive;
         float absSample = std::abs( outputSample ); // signal level used for threshold comparison
 
-        if ( absSample > _squareWaveThreshold )
+        if ( absSample > squareWaveThreshold )
         {
             // driven signal is above threshold, hard clip it
             outputSample = juce::jlimit( -1.0f, 1.0f, outputSample );
         }
-        else if ( absSample > _cutoffThreshold )
+        else if ( absSample > cutoffThreshold )
         {
             // when between square wave and cutoff thresholds, the signal should become a square wave
             outputSample = outputSample > 0.0f ? 1.0f : -1.0f;
@@ -55,6 +63,59 @@ void Fuzz::apply( float* channelData, unsigned long bufferSize )
     }
 }
 
+void Fuzz::apply( float* channelData, unsigned long bufferSize, AntiAliasing::State& state, const ParameterRamps* ramps )
+{
+    const auto order = _antiAliasing.load();
+
+    if ( order == AntiAliasing::Order::Off ) {
+        state.push( channelData, bufferSize );
+
+        if ( ramps != nullptr ) {
+            applyRamped( channelData, bufferSize, *ramps );
+        } else {
+            apply( channelData, bufferSize );
+        }
+        return;
+    }
+
+    if ( ramps == nullptr ) {
+        applyAntiAliased( channelData, bufferSize, state, order, _squareWaveThreshold.load(), _cutoffThreshold.load(), _input * _drive );
+        return;
+    }
+
+    // the anti-aliased curve follows the ramps in chunks (see ParameterRamps::CHUNK_SIZE)
+
+    for ( size_t offset = 0; offset < bufferSize; offset += ParameterRamps::CHUNK_SIZE )
+    {
+        const size_t index = ramps->index( offset );
+
+        applyAntiAliased(
+            channelData + offset, static_cast<unsigned long>( std::min<size_t>( ParameterRamps::CHUNK_SIZE, bufferSize - offset )), state, order,
+            ramps->drive[ index ], ramps->param[ index ], ramps->level[ index ] * _drive
+        );
+    }
+}
+
+void Fuzz::setAntiAliasing( AntiAliasing::Order order )
+{
+    _antiAliasing.store( order );
+}
+
+void Fuzz::setLookupTableEnabled( bool enabled )
+{
+    _table.setEnabled( enabled );
+}
+
+void Fuzz::setLookupTableSynchronous( bool synchronous )
+{
+    _table.setSynchronous( synchronous );
+}
+
+void Fuzz::updateLookupTable()
+{
+    _table.update();
+}
+
 /*  setters */
 
 void Fuzz::setDrive( float value )
@@ -69,10 +130,116 @@ void Fuzz::setInputLevel( float value )
 
 void Fuzz::setCutOff( float value )
 {
-    _cutoffThreshold = value;
+    if ( value != _cutoffThreshold.exchange( value )) {
+        _table.invalidate();
+    }
 }
 
 void Fuzz::setThreshold( float value )
 {
-    _squareWaveThreshold = value;
+    if ( value != _squareWaveThreshold.exchange( value )) {
+        _table.invalidate();
+    }
+}
+
+/* private methods */
+
+void Fuzz::applyTable( const float* table, float* channelData, unsigned long bufferSize )
+{
+    const float gain = _input * _drive;
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const float outputSample = channelData[ i ] * gain;
+        const float shaped = TransferTable::lookup( table, std::abs( outputSample )); // clamps beyond full scale
+
+        channelData[ i ] = outputSample < 0.0f ? -shaped : shaped;
+    }
+}
+
+void Fuzz::applyAntiAliased(
+    float* channelData, unsigned long bufferSize, AntiAliasing::State& state, AntiAliasing::Order order,
+    double squareWaveThreshold, double cutoffThreshold, double gain
+) {
+    // the curve (and its antiderivatives) are expressed in terms of the driven signal, where
+    // a = | driven signal |, s = square wave threshold and c = cutoff threshold
+
+    const double s = squareWaveThreshold;
+    const double c = cutoffThreshold;
+
+    const double clippedIntegralAtS = clippedIntegral( s );
+    const double gatedDoubleIntegralAtS = c < s ? 0.5 * ( s - c ) * ( s - c ) : 0.0;
+
+    auto function = [ s, c ]( double driven ) {
+        const double a = std::abs( driven );
+        const double shaped = a > s ? std::min( a, 1.0 ) : ( a > c ? 1.0 : 0.0 );
+        return driven < 0.0 ? -shaped : shaped;
+    };
+
+    // the curve is odd, so its first antiderivative is even
+
+    auto integral = [ s, c, clippedIntegralAtS ]( double driven ) {
+        const double a = std::abs( driven );
+        const double gated = std::max( 0.0, std::min( a, s ) - c ); // area of the square wave section
+        return a > s ? gated + clippedIntegral( a ) - clippedIntegralAtS : gated;
+    };
+
+    // and its second antiderivative is odd
+
+    auto doubleIntegral = [ s, c, clippedIntegralAtS, gatedDoubleIntegralAtS ]( double driven ) {
+        const double a = std::abs( driven );
+        double result;
+
+        if ( a <= s ) {
+            result = a > c ? 0.5 * ( a - c ) * ( a - c ) : 0.0;
+        } else {
+            result = gatedDoubleIntegralAtS + std::max( 0.0, s - c ) * ( a - s ) +
+                     clippedDoubleIntegral( a ) - clippedDoubleIntegral( s ) - clippedIntegralAtS * ( a - s );
+        }
+        return driven < 0.0 ? -result : result;
+    };
+
+    if ( order == AntiAliasing::Order::First ) {
+        AntiAliasing::applyFirstOrder( channelData, bufferSize, state, gain, function, integral );
+    } else {
+        AntiAliasing::applySecondOrder( channelData, bufferSize, state, gain, function, integral, doubleIntegral );
+    }
+}
+
+void Fuzz::applyRamped( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps )
+{
+    // equal to the direct path of apply(), with the thresholds and input level read per sample
+
+    const float drive = _drive;
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const size_t index = ramps.index( i );
+
+        const float outputSample = channelData[ i ] * ramps.level[ index ] * drive;
+        const float absSample    = std::abs( outputSample );
+        const float square       = outputSample > 0.0f ? 1.0f : -1.0f;
+
+        channelData[ i ] = absSample > ramps.drive[ index ] ? juce::jlimit( -1.0f, 1.0f, outputSample )
+                         : absSample > ramps.param[ index ] ? square : 0.0f;
+    }
+}
+
+void Fuzz::renderTable( float* table, int numPoints )
+{
+    const float squareWaveThreshold = _squareWaveThreshold.load();
+    const float cutoffThreshold     = _cutoffThreshold.load();
+
+    for ( int i = 0; i < numPoints; ++i )
+    {
+        const float level = static_cast<float>( i ) / static_cast<float>( numPoints - 1 );
+
+        if ( level > squareWaveThreshold ) {
+            table[ i ] = level;
+        } else if ( level > cutoffThreshold ) {
+            table[ i ] = 1.0f;
+        } else {
+            table[ i ] = 0.0f;
+        }
+    }
 }
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../antialiasing/AntiAliasing.h"
+#include "../smoother/ParameterRamps.h"
+#include "../transfertable/TransferTable.h"
 
 class Fuzz
 {
@@ -30,9 +33,42 @@ class Fuzz
         
         void apply( float* channelData, unsigned long bufferSize );
 
+        // applies the fuzz with anti-aliasing (when enabled), using provided history of the processed signal
+        // and the per-sample parameter values provided by ramps (when not nullptr)
+        void apply( float* channelData, unsigned long bufferSize, AntiAliasing::State& state, const ParameterRamps* ramps = nullptr );
+        void setAntiAliasing( AntiAliasing::Order order );
+
+        // see TransferTable
+        void setLookupTableEnabled( bool enabled );
+        void setLookupTableSynchronous( bool synchronous );
+        void updateLookupTable();
+
     private:
         float _input;
         float _drive;
-        float _cutoffThreshold; // Below this threshold, silence the output
-        float _squareWaveThreshold; // Below this threshold, signal is converted to a square wave
+        std::atomic<float> _cutoffThreshold { 0.f }; // Below this threshold, silence the output
+        std::atomic<float> _squareWaveThreshold { 0.f }; // Below this threshold, signal is converted to a square wave
+        std::atomic<AntiAliasing::Order> _antiAliasing { AntiAliasing::Order::Off };
+
+        // the transfer table spans the driven signal magnitude from 0 to 1 (above which the signal is clipped)
+
+        TransferTable _table; // declared last as its renderer refers to the members above
+
+        void applyTable( const float* table, float* channelData, unsigned long bufferSize );
+        void applyRamped( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps );
+        void applyAntiAliased(
+            float* channelData, unsigned long bufferSize, AntiAliasing::State& state, AntiAliasing::Order order,
+            double squareWaveThreshold, double cutoffThreshold, double gain
+        );
+        void renderTable( float* table, int numPoints );
+
+        // antiderivatives of the clipping section of the curve ( min( a, 1 )), used for anti-aliasing
+
+        static inline double clippedIntegral( double a ) {
+            return a < 1.0 ? 0.5 * a * a : a - 0.5;
+        }
+
+        static inline double clippedDoubleIntegral( double a ) {
+            return a < 1.0 ? a * a * a / 6.0 : 0.5 * a * a - 0.5 * a + 1.0 / 6.0;
+        }
 };
@@ -18,41 +18,123 @@
 
 /* public methods */
 
-void AutoMakeUpGain::prepare( double sampleRate )
+void AutoMakeUpGain::prepare( double sampleRate, int maxBlockSize )
 {
-    rmsWindowSize = static_cast<int>( sampleRate * WINDOW_SIZE );
-    rmsWindowSize = std::max( 1, rmsWindowSize );
+    rmsWindowSize = std::max( 1, static_cast<int>( sampleRate * WINDOW_SIZE ) / SEGMENT_SIZE );
 
-    gainSmoothed.reset( sampleRate, GAIN_SMOOTHING );
-    gainSmoothed.setCurrentAndTargetValue( 1.0f );
+    // analyse() can run ahead of apply() by a block
+
+    const int lookAhead = maxBlockSize / SEGMENT_SIZE + 2;
+    segments.assign( static_cast<size_t>( rmsWindowSize + lookAhead ), {});
+
+    preIndex  = postIndex = 0;
+    prePosition = postPosition = 0;
+    preSum = postSum = 0.0;
+
+    gain     = 1.f;
+    gainStep = 0.f;
+    gainCoefficient = static_cast<float>( 1.0 - std::exp( -SEGMENT_SIZE / ( GAIN_SMOOTHING * sampleRate )));
 }
 
-void AutoMakeUpGain::apply( float* pre, float* post, int bufferSize  )
+void AutoMakeUpGain::analyse( const float* pre, int bufferSize )
 {
-    float inRMS  = computeRMS( pre, bufferSize );
-    float outRMS = computeRMS( post, bufferSize );
+    while ( bufferSize > 0 ) {
+        const int run = std::min( bufferSize, SEGMENT_SIZE - prePosition );
 
-    float makeup = ( outRMS > 1e-9f ) ? ( inRMS / outRMS ) : 1.0f;
+        segments[ preIndex ].pre += sumOfSquares( pre, run );
 
-    makeup = juce::jlimit( 0.25f, 4.0f, makeup );
+        pre          += run;
+        bufferSize   -= run;
+        prePosition  += run;
+
+        if ( prePosition == SEGMENT_SIZE ) {
+            prePosition = 0;
+            preIndex    = preIndex + 1 == segments.size() ? 0 : preIndex + 1;
+        }
+    }
+}
+
+void AutoMakeUpGain::apply( float* post, int bufferSize )
+{
+    while ( bufferSize > 0 ) {
+        const int run = std::min( bufferSize, SEGMENT_SIZE - postPosition );
+
+        // measure the level prior to applying the gain
+
+        segments[ postIndex ].post += sumOfSquares( post, run );
+
+        const float start = gain;
+        const float step  = gainStep;
 
-    gainSmoothed.setTargetValue( makeup );
-    float smoothGain = gainSmoothed.getNextValue();
-    gainSmoothed.skip( bufferSize );
+        for ( int i = 0; i < run; ++i ) {
+            post[ i ] *= start + step * static_cast<float>( i + 1 );
+        }
+        gain += step * static_cast<float>( run );
 
-    for ( int n = 0; n < bufferSize; ++n ) {
-        post[ n ] *= smoothGain;
+        post         += run;
+        bufferSize   -= run;
+        postPosition += run;
+
+        if ( postPosition == SEGMENT_SIZE ) {
+            completeSegment();
+        }
     }
 }
 
 /* private methods */
 
-float AutoMakeUpGain::computeRMS( const float* data, int numSamples )
+void AutoMakeUpGain::completeSegment()
+{
+    // move the window onto the completed segment (the segment leaving the window is cleared
+    // as it is next to be analysed once the look ahead wraps around the ring)
+
+    const size_t size = segments.size();
+    const size_t window = static_cast<size_t>( rmsWindowSize );
+
+    auto& completed = segments[ postIndex ];
+    auto& leaving   = segments[ postIndex >= window ? postIndex - window : postIndex + size - window ];
+
+    preSum  = std::max( 0.0, preSum  + completed.pre  - leaving.pre );
+    postSum = std::max( 0.0, postSum + completed.post - leaving.post );
+
+    leaving = {};
+
+    postPosition = 0;
+    postIndex    = postIndex + 1 == size ? 0 : postIndex + 1;
+
+    // determine the gain at the end of the next segment (the ratio of the RMS of both windows, where
+    // the processed signal must exceed an RMS of 1e-9)
+
+    const double windowSamples = static_cast<double>( rmsWindowSize ) * SEGMENT_SIZE;
+    const double offset = 1e-12 * windowSamples;
+
+    float makeup = ( postSum > 1e-18 * windowSamples ) ? static_cast<float>( std::sqrt(( preSum + offset ) / ( postSum + offset ))) : 1.0f;
+
+    makeup = juce::jlimit( 0.25f, 4.0f, makeup );
+
+    gainStep = ( makeup - gain ) * gainCoefficient / static_cast<float>( SEGMENT_SIZE );
+}
+
+float AutoMakeUpGain::sumOfSquares( const float* data, int numSamples )
 {
-    double sumSquares = 0.0;
+    // accumulated in separate lanes, which allows the compiler to vectorize the loop (without reordering the sum)
+
+    constexpr int LANES = 8;
+    float lanes[ LANES ] = {};
+    int i = 0;
 
-    for ( int i = 0; i < numSamples; ++i ) {
-        sumSquares += data[ i ] * data[ i ];
+    for ( ; i + LANES <= numSamples; i += LANES ) {
+        for ( int lane = 0; lane < LANES; ++lane ) {
+            lanes[ lane ] += data[ i + lane ] * data[ i + lane ];
+        }
     }
-    return static_cast<float>( std::sqrt( sumSquares / ( double ) numSamples + 1e-12 ));
-}
\ No newline at end of file
+    float sum = 0.f;
+
+    for ( ; i < numSamples; ++i ) {
+        sum += data[ i ] * data[ i ];
+    }
+    for ( int lane = 0; lane < LANES; ++lane ) {
+        sum += lanes[ lane ];
+    }
+    return sum;
+}
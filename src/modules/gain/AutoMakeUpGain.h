@@ -19,6 +19,14 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 
+/**
+ * Matches the level of a processed signal to the level of the signal prior to processing.
+ *
+ * The levels are measured as the RMS over a sliding window of WINDOW_SIZE. The window is divided into segments
+ * of SEGMENT_SIZE samples, of which the sums of squares are kept in a ring, so the window moves with a single
+ * addition and subtraction per segment. The gain is updated once per segment (e.g. at a fixed control rate regardless
+ * of the block size) and interpolated linearly across the samples of the next segment.
+ */
 class AutoMakeUpGain
 {
     // values are in seconds
@@ -26,18 +34,48 @@ class AutoMakeUpGain
     static constexpr double WINDOW_SIZE    = 0.02;
     static constexpr double GAIN_SMOOTHING = 0.01;
 
+    static constexpr int SEGMENT_SIZE = 32; // in samples
+
     public:
-        void prepare( double sampleRate );
+        // prepares for blocks of up to maxBlockSize samples (resets all state)
+        void prepare( double sampleRate, int maxBlockSize );
+
+        /**
+         * Measures the level of the signal prior to processing, to be invoked before
+         * apply() with the same samples (prior to being processed)
+         */
+        void analyse( const float* pre, int bufferSize );
 
         /**
-         * Apply makeup gain to make the differences between
-         * provided pre- and post buffer states smaller
+         * Apply makeup gain to make the differences between the level of the
+         * processed signal and that of the signal provided to analyse() smaller
          */
-        void apply( float* pre, float* post, int bufferSize );
+        void apply( float* post, int bufferSize );
 
     private:
-        int rmsWindowSize = 0;
-        juce::SmoothedValue<float> gainSmoothed;
+        struct Segment
+        {
+            float pre  = 0.f; // the sums of squares of the segment
+            float post = 0.f;
+        };
+
+        int rmsWindowSize = 0; // in segments
+
+        // the segments of the window followed by the segments analysed ahead of apply()
+        std::vector<Segment> segments;
+        size_t preIndex  = 0; // the segment being analysed
+        size_t postIndex = 0; // the segment being applied onto
+        int prePosition  = 0; // within the segment
+        int postPosition = 0;
+
+        double preSum  = 0.0; // the sums of squares of the window
+        double postSum = 0.0;
+
+        float gain     = 1.f;
+        float gainStep = 0.f; // per sample, during the current segment
+        float gainCoefficient = 1.f; // the one-pole smoothing of the gain, per segment
+
+        void completeSegment();
 
-        float computeRMS( const float* data, int numSamples );
+        static float sumOfSquares( const float* data, int numSamples );
 };
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ModulationMatrix.h"
+#include "../../utils/MathUtilities.h"
+
+/* public methods */
+
+double ModulationMatrix::getBeatsPerCycle( int rate, int timeSigNumerator, int timeSigDenominator )
+{
+    // in order of ParameterUtilities::getLFORateNames(), the bars are converted using the time signature
+
+    const double bar = timeSigDenominator > 0 ? timeSigNumerator * 4.0 / timeSigDenominator : 4.0;
+
+    switch ( rate ) {
+        case 0:  return bar * 4.0;
+        case 1:  return bar * 2.0;
+        case 2:  return bar;
+        case 3:  return 2.0;
+        case 4:  return 1.0;
+        case 5:  return 2.0 / 3.0;
+        case 6:  return 0.5;
+        case 7:  return 1.0 / 3.0;
+        case 8:  return 0.25;
+        case 9:  return 1.0 / 6.0;
+        default: return 0.125;
+    }
+}
+
+void ModulationMatrix::prepare( double sampleRate, int maxBlockSize )
+{
+    _sampleRate   = sampleRate;
+    _maxBlockSize = juce::jmax( 0, maxBlockSize );
+
+    const auto maxPoints = static_cast<size_t>( _maxBlockSize / CONTROL_INTERVAL + 2 );
+
+    for ( auto& values : _sources ) {
+        values.resize( maxPoints );
+    }
+    for ( auto& values : _targets ) {
+        values.resize( maxPoints );
+    }
+    setEnvelope( _attackTime, _releaseTime );
+    reset();
+}
+
+void ModulationMatrix::reset()
+{
+    for ( auto& lfo : _lfos ) {
+        lfo.phase = 0.0;
+    }
+    _envelope   = 0.f;
+    _numSamples = 0;
+    _numPoints  = 1;
+
+    for ( auto& values : _sources ) {
+        std::fill( values.begin(), values.end(), 0.f );
+    }
+    for ( auto& values : _targets ) {
+        std::fill( values.begin(), values.end(), 0.f );
+    }
+}
+
+void ModulationMatrix::setLFO( int lfo, double beatsPerCycle, Shape shape )
+{
+    auto& properties = _lfos[ static_cast<size_t>( lfo )];
+
+    properties.beatsPerCycle = juce::jmax( 1.0 / 64.0, beatsPerCycle );
+    properties.shape = shape;
+}
+
+void ModulationMatrix::setEnvelope( float attackInSeconds, float releaseInSeconds )
+{
+    _attackTime  = attackInSeconds;
+    _releaseTime = releaseInSeconds;
+    _attack      = getCoefficient( _attackTime, CONTROL_INTERVAL );
+    _release     = getCoefficient( _releaseTime, CONTROL_INTERVAL );
+}
+
+void ModulationMatrix::setRoute( int route, Source source, int target, float depth )
+{
+    auto& properties = _routes[ static_cast<size_t>( route )];
+
+    properties.source = source;
+    properties.target = juce::jlimit( 0, NumTargets - 1, target );
+    properties.depth  = juce::jlimit( -1.f, 1.f, depth );
+
+    updateRoutes();
+}
+
+void ModulationMatrix::process( const float* const* channels, int numChannels, int numSamples, double tempo, double songPosition, bool isPlaying )
+{
+    _numSamples = juce::jlimit( 0, _maxBlockSize, numSamples );
+    _numPoints  = ( _numSamples + CONTROL_INTERVAL - 1 ) / CONTROL_INTERVAL + 1;
+
+    if ( !_active ) {
+        return;
+    }
+
+    // render the sources in use
+
+    for ( int lfo = 0; lfo < NUM_LFOS; ++lfo ) {
+        if ( _used[ static_cast<size_t>( lfo )]) {
+            renderLFO( lfo, tempo, songPosition, isPlaying );
+        }
+    }
+
+    if ( _used[ static_cast<size_t>( Source::Envelope ) - 1 ]) {
+        renderEnvelope( channels, numChannels );
+    }
+
+    // sum the routes of each modulated target
+
+    const auto numPoints = static_cast<size_t>( _numPoints );
+
+    for ( size_t target = 0; target < _targets.size(); ++target ) {
+        if ( !_modulated[ target ]) {
+            continue;
+        }
+        float* values = _targets[ target ].data();
+        std::fill( values, values + numPoints, 0.f );
+
+        for ( const auto& route : _routes ) {
+            if ( route.source == Source::Off || route.target != static_cast<int>( target ) || route.depth == 0.f ) {
+                continue;
+            }
+            const float* source = _sources[ static_cast<size_t>( route.source ) - 1 ].data();
+            const float depth   = route.depth;
+
+            for ( size_t point = 0; point < numPoints; ++point ) {
+                values[ point ] += source[ point ] * depth;
+            }
+        }
+    }
+}
+
+void ModulationMatrix::render( int target, const float* base, float* output, float scale, float minimum, float maximum ) const
+{
+    const float* values = _targets[ static_cast<size_t>( target )].data();
+
+    for ( int point = 0; point < _numPoints - 1; ++point ) {
+        const int start  = point * CONTROL_INTERVAL;
+        const int length = juce::jmin( CONTROL_INTERVAL, _numSamples - start );
+
+        const float from = values[ point ] * scale;
+        const float step = ( values[ point + 1 ] - values[ point ]) * scale / static_cast<float>( length );
+
+        const float* in = base + start;
+        float* out = output + start;
+
+        for ( int i = 0; i < length; ++i ) {
+            out[ i ] = std::min( maximum, std::max( minimum, in[ i ] + from + step * static_cast<float>( i )));
+        }
+    }
+}
+
+/* private methods */
+
+void ModulationMatrix::updateRoutes()
+{
+    _used.fill( false );
+    _modulated.fill( false );
+    _active = false;
+
+    for ( const auto& route : _routes ) {
+        if ( route.source == Source::Off || route.depth == 0.f ) {
+            continue;
+        }
+        _used[ static_cast<size_t>( route.source ) - 1 ] = true;
+        _modulated[ static_cast<size_t>( route.target )] = true;
+        _active = true;
+    }
+}
+
+void ModulationMatrix::renderLFO( int index, double tempo, double songPosition, bool isPlaying )
+{
+    auto& lfo = _lfos[ static_cast<size_t>( index )];
+    float* values = _sources[ static_cast<size_t>( index )].data();
+
+    // the phase increment per sample, while playing the phase at the start of the block follows from the song position
+
+    const double increment = ( tempo > 0.0 ? tempo : 120.0 ) / 60.0 / _sampleRate / lfo.beatsPerCycle;
+    const double start     = isPlaying && songPosition >= 0.0 ? songPosition / lfo.beatsPerCycle : lfo.phase;
+    const double phase     = start - std::floor( start );
+
+    lfo.phase = phase + increment * _numSamples;
+    lfo.phase -= std::floor( lfo.phase );
+
+    // the phase of each control point (the last point is at the end of the block), followed by the shape
+
+    const float startPhase = static_cast<float>( phase );
+    const float step       = static_cast<float>( increment );
+    const int numPoints    = _numPoints;
+
+    for ( int point = 0; point < numPoints; ++point ) {
+        const float position = static_cast<float>( std::min( point * CONTROL_INTERVAL, _numSamples ));
+        const float value    = startPhase + position * step;
+
+        values[ point ] = value - MathUtilities::fastFloor( value );
+    }
+
+    switch ( lfo.shape )
+    {
+        case Shape::Sine:
+            // parabolic approximation, refined to a maximum error of 0.001
+
+            for ( int point = 0; point < numPoints; ++point ) {
+                const float t = values[ point ] - MathUtilities::fastFloor( values[ point ] + 0.5f ); // -0.5 to 0.5
+                const float y = 8.f * t - 16.f * t * std::abs( t );
+
+                values[ point ] = 0.225f * ( y * std::abs( y ) - y ) + y;
+            }
+            break;
+
+        case Shape::Triangle:
+            for ( int point = 0; point < numPoints; ++point ) {
+                float t = values[ point ] + 0.25f;
+                t -= MathUtilities::fastFloor( t );
+
+                values[ point ] = 1.f - 4.f * std::abs( t - 0.5f );
+            }
+            break;
+
+        case Shape::RampUp:
+            for ( int point = 0; point < numPoints; ++point ) {
+                values[ point ] = values[ point ] * 2.f - 1.f;
+            }
+            break;
+
+        case Shape::RampDown:
+            for ( int point = 0; point < numPoints; ++point ) {
+                values[ point ] = 1.f - values[ point ] * 2.f;
+            }
+            break;
+
+        case Shape::Square:
+            for ( int point = 0; point < numPoints; ++point ) {
+                values[ point ] = values[ point ] < 0.5f ? 1.f : -1.f;
+            }
+            break;
+    }
+}
+
+void ModulationMatrix::renderEnvelope( const float* const* channels, int numChannels )
+{
+    float* values = _sources[ static_cast<size_t>( Source::Envelope ) - 1 ].data();
+
+    // the first point is the level at the end of the previous block, each following
+    // point tracks the peak level of all channels in the interval preceding it
+
+    values[ 0 ] = std::min( _envelope, 1.f );
+
+    for ( int point = 1; point < _numPoints; ++point ) {
+        const int start  = ( point - 1 ) * CONTROL_INTERVAL;
+        const int length = juce::jmin( CONTROL_INTERVAL, _numSamples - start );
+
+        float peak = 0.f;
+
+        for ( int channel = 0; channel < numChannels; ++channel ) {
+            const float* data = channels[ channel ];
+
+            if ( data == nullptr ) {
+                continue;
+            }
+            for ( int i = start; i < start + length; ++i ) {
+                peak = std::max( peak, std::abs( data[ i ]));
+            }
+        }
+
+        // the last interval of a block can be shorter
+
+        const bool isRising = peak > _envelope;
+        const float coefficient = length == CONTROL_INTERVAL ? ( isRising ? _attack : _release )
+                                                             : getCoefficient( isRising ? _attackTime : _releaseTime, length );
+
+        _envelope += ( peak - _envelope ) * coefficient;
+        values[ point ] = std::min( _envelope, 1.f );
+    }
+}
+
+float ModulationMatrix::getCoefficient( float duration, int numSamples ) const
+{
+    const double samples = juce::jmax( 1.0, static_cast<double>( duration ) * _sampleRate );
+    return static_cast<float>( 1.0 - std::exp( -numSamples / samples ));
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "../../Parameters.h"
+#include <array>
+#include <vector>
+
+/**
+ * Renders the modulation sources (two tempo-synced LFOs and an envelope follower) and sums the routes connecting
+ * them to their targets : the split frequencies and the drive and param of each band slot.
+ *
+ * Modulation is computed at control rate : once per block, process() renders the value of each source in use at
+ * every CONTROL_INTERVAL samples (and at the end of the block), after which the modulation of each target is the sum
+ * of its routes. Each of these is a single vectorizable loop over the control points. Sources and targets that no
+ * route uses are skipped entirely, which lets the processor recompute only the parameters that are actually modulated
+ * (see isModulated()). Where per-sample values are needed, render() interpolates the control points.
+ *
+ * While the transport is playing, the LFO phases follow the song position (so the modulation is in sync with the
+ * arrangement and repeats identically on each playback), otherwise the LFOs run freely at the current tempo.
+ */
+class ModulationMatrix
+{
+    public:
+        static constexpr int CONTROL_INTERVAL = 32; // the amount of samples between control points
+        static constexpr int NUM_LFOS   = Parameters::NUM_LFOS;
+        static constexpr int NUM_ROUTES = Parameters::NUM_ROUTES;
+        static constexpr int MAX_SLOTS  = Parameters::MAX_BANDS;
+
+        enum class Source {
+            Off = 0,
+            LFO1,
+            LFO2,
+            Envelope
+        };
+
+        enum class Shape {
+            Sine = 0,
+            Triangle,
+            RampUp,
+            RampDown,
+            Square
+        };
+
+        // the split frequencies, followed by the drive and param of each band slot (see getDriveTarget() and getParamTarget())
+
+        enum Target {
+            SplitFrequency = 0,
+            NumTargets = 1 + MAX_SLOTS * 2
+        };
+
+        static constexpr int getDriveTarget( int slot ) { return 1 + slot * 2; }
+        static constexpr int getParamTarget( int slot ) { return 2 + slot * 2; }
+
+        // the length of a cycle (in quarter notes) for provided rate (see ParameterUtilities::getLFORateNames())
+        static double getBeatsPerCycle( int rate, int timeSigNumerator, int timeSigDenominator );
+
+        /**
+         * Allocates the control points for blocks of up to maxBlockSize samples and
+         * resets the state of the sources. Should not be invoked during processing.
+         */
+        void prepare( double sampleRate, int maxBlockSize );
+        void reset();
+
+        /* configuration (on the audio thread, in between blocks) */
+
+        void setLFO( int lfo, double beatsPerCycle, Shape shape );
+        void setEnvelope( float attackInSeconds, float releaseInSeconds );
+
+        // a route with a depth of 0 (or without source) is inactive. Depth is within the -1 to 1 range, where the
+        // LFOs are bipolar (-1 to 1) and the envelope is unipolar (0 to 1)
+        void setRoute( int route, Source source, int target, float depth );
+
+        // whether provided target has an active route
+        bool isModulated( int target ) const {
+            return _modulated[ static_cast<size_t>( target )];
+        }
+
+        // whether any target has an active route
+        bool isActive() const { return _active; }
+
+        /**
+         * Renders the sources in use and the modulation of all modulated targets for a block of numSamples (up to
+         * maxBlockSize). The envelope follows the peak level of provided channels (which can contain nullptr for
+         * channels to ignore). Tempo is in beats per minute, songPosition is the position (in quarter notes) at
+         * the start of the block and only used while playing.
+         */
+        void process( const float* const* channels, int numChannels, int numSamples, double tempo, double songPosition, bool isPlaying );
+
+        // the modulation of provided target at the end of the last processed block
+        float getValue( int target ) const {
+            return _targets[ static_cast<size_t>( target )][ static_cast<size_t>( _numPoints - 1 )];
+        }
+
+        /**
+         * Writes the per-sample values of a target during the last processed block into output : the modulation
+         * (interpolated between the control points) multiplied by scale and added to the values of base, clamped to
+         * the minimum - maximum range. Base and output can be the same buffer.
+         */
+        void render( int target, const float* base, float* output, float scale, float minimum, float maximum ) const;
+
+    private:
+        struct LFO
+        {
+            double beatsPerCycle = 4.0;
+            Shape shape = Shape::Sine;
+            double phase = 0.0; // of the free-running LFO, within the 0 - 1 range
+        };
+
+        struct Route
+        {
+            Source source = Source::Off;
+            int target = SplitFrequency;
+            float depth = 0.f;
+        };
+
+        static constexpr int NUM_SOURCES = 3; // excluding Source::Off
+
+        double _sampleRate = 44100.0;
+        int _maxBlockSize  = 0;
+
+        std::array<LFO, NUM_LFOS> _lfos;
+        std::array<Route, NUM_ROUTES> _routes;
+
+        float _attackTime  = 0.01f; // in seconds
+        float _releaseTime = 0.2f;
+        float _attack  = 1.f; // the coefficients per CONTROL_INTERVAL
+        float _release = 1.f;
+        float _envelope = 0.f;
+
+        // the control points of the last processed block, point n applies to sample
+        // n * CONTROL_INTERVAL (where the last point applies to the end of the block)
+
+        int _numSamples = 0;
+        int _numPoints  = 1;
+        std::array<std::vector<float>, NUM_SOURCES> _sources; // the values of each source (in order of Source, excluding Off)
+        std::array<std::vector<float>, NumTargets> _targets; // the summed routes of each target
+
+        std::array<bool, NUM_SOURCES> _used {}; // whether a source has an active route
+        std::array<bool, NumTargets> _modulated {};
+        bool _active = false;
+
+        void updateRoutes();
+        void renderLFO( int lfo, double tempo, double songPosition, bool isPlaying );
+        void renderEnvelope( const float* const* channels, int numChannels );
+
+        // the coefficient of the envelope follower for provided duration (in seconds) over provided amount of samples
+        float getCoefficient( float duration, int numSamples ) const;
+};
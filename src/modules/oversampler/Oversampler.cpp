@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Oversampler.h"
+#include <cmath>
+
+namespace
+{
+    /* half-band filter design */
+
+    // The coefficients of the allpass sections are derived from an elliptic half-band filter prototype (after
+    // the polyphase IIR design described by Laurent de Soras for HIIR). For a given amount of coefficients the
+    // transition bandwidth (relative to the higher sample rate of an octave) determines the stopband attenuation.
+
+    struct Specification
+    {
+        int numCoefficients;
+        double transitionBandwidth;
+    };
+
+    // octave 0 passes up to 20.2 kHz at 44.1 kHz with ~99 dB attenuation, the higher octaves only have to reject the
+    // images of the octaves below them (the band above 0.5 of the host rate is already suppressed) and can be much shallower
+
+    constexpr Specification SPECIFICATIONS[] = {
+        { 8, 0.04  }, // ~99 dB
+        { 4, 0.25  }, // ~117 dB
+        { 2, 0.375 }  // ~94 dB
+    };
+
+    double sumSeries( double q, int order, int c, bool numerator )
+    {
+        double sum  = 0.0;
+        double sign = numerator ? 1.0 : -1.0;
+
+        for ( int i = numerator ? 0 : 1;; ++i ) {
+            const double term = numerator
+                ? std::pow( q, i * ( i + 1 )) * std::sin(( i * 2 + 1 ) * c * juce::MathConstants<double>::pi / order ) * sign
+                : std::pow( q, i * i ) * std::cos( i * 2 * c * juce::MathConstants<double>::pi / order ) * sign;
+
+            sum += term;
+            sign = -sign;
+
+            if ( std::abs( term ) < 1e-100 ) {
+                return sum;
+            }
+        }
+    }
+
+    std::vector<double> designHalfBand( const Specification& specification )
+    {
+        double k = std::tan(( 1.0 - specification.transitionBandwidth * 2.0 ) * juce::MathConstants<double>::pi / 4.0 );
+        k *= k;
+
+        const double kk = std::pow( 1.0 - k * k, 0.25 );
+        const double e  = 0.5 * ( 1.0 - kk ) / ( 1.0 + kk );
+        const double e4 = e * e * e * e;
+        const double q  = e * ( 1.0 + e4 * ( 2.0 + e4 * ( 15.0 + 150.0 * e4 )));
+
+        const int order = specification.numCoefficients * 2 + 1;
+        std::vector<double> coefficients;
+
+        for ( int c = 1; c <= specification.numCoefficients; ++c ) {
+            const double w  = sumSeries( q, order, c, true ) * std::pow( q, 0.25 ) / ( sumSeries( q, order, c, false ) + 0.5 );
+            const double w2 = w * w;
+            const double x  = std::sqrt(( 1.0 - w2 * k ) * ( 1.0 - w2 / k )) / ( 1.0 + w2 );
+
+            coefficients.push_back(( 1.0 - x ) / ( 1.0 + x ));
+        }
+        return coefficients;
+    }
+}
+
+/* constructor */
+
+Oversampler::Oversampler()
+{
+    reset();
+}
+
+/* public methods */
+
+void Oversampler::Buffers::prepare( int maxBlockSize )
+{
+    const auto size = static_cast<size_t>( maxBlockSize ) << MAX_ORDER;
+
+    for ( auto* buffers : { &lo, &hi }) {
+        for ( auto& buffer : *buffers ) {
+            buffer.assign( size, 0.f );
+        }
+    }
+}
+
+void Oversampler::setOrder( int order )
+{
+    order = juce::jlimit( 0, MAX_ORDER, order );
+
+    if ( order == _order ) {
+        return;
+    }
+    _order = order;
+    _latencySamples = static_cast<int>( std::round( getLatency( order )));
+
+    reset();
+}
+
+void Oversampler::reset()
+{
+    for ( auto* filters : { &_upsamplers, &_downsamplers }) {
+        for ( auto& filter : *filters ) {
+            filter.x.fill( {} );
+            filter.y.fill( {} );
+        }
+    }
+    _delayLine.fill( 0.f );
+    _delayIndex = 0;
+}
+
+float Oversampler::getLatency( int order )
+{
+    const auto& octaves = getOctaves();
+    float latency = 0.f;
+
+    for ( int octave = 0; octave < juce::jlimit( 0, MAX_ORDER, order ); ++octave ) {
+        latency += octaves[ static_cast<size_t>( octave )].latency / static_cast<float>( 1 << octave );
+    }
+    return latency;
+}
+
+size_t Oversampler::upsample( const float* lo, const float* hi, int numSamples, Buffers& buffers )
+{
+    const auto& octaves = getOctaves();
+    size_t index = 0;
+
+    if ( _order == 0 ) {
+        std::copy( lo, lo + numSamples, buffers.lo[ index ].begin());
+        std::copy( hi, hi + numSamples, buffers.hi[ index ].begin());
+        return index;
+    }
+
+    // each octave doubles the amount of samples, the buffers are alternated between octaves
+
+    const float* inLo = lo;
+    const float* inHi = hi;
+
+    for ( size_t octave = 0; octave < static_cast<size_t>( _order ); ++octave ) {
+        index = octave % 2;
+
+        const auto& design = octaves[ octave ];
+        Filter filter = _upsamplers[ octave ]; // local copy, allows the compiler to keep the state in registers
+
+        float* outLo = buffers.lo[ index ].data();
+        float* outHi = buffers.hi[ index ].data();
+
+        for ( int i = 0; i < numSamples; ++i ) {
+            Vector v { inLo[ i ], inLo[ i ], inHi[ i ], inHi[ i ] };
+            processStages( design, filter, v );
+
+            outLo[ i * 2 ]     = v.lane[ 0 ];
+            outLo[ i * 2 + 1 ] = v.lane[ 1 ];
+            outHi[ i * 2 ]     = v.lane[ 2 ];
+            outHi[ i * 2 + 1 ] = v.lane[ 3 ];
+        }
+        _upsamplers[ octave ] = filter;
+
+        inLo = outLo;
+        inHi = outHi;
+        numSamples *= 2;
+    }
+    return index;
+}
+
+void Oversampler::downsample( Buffers& buffers, size_t index, float* lo, float* hi, int numSamples )
+{
+    const auto& octaves = getOctaves();
+
+    float* bufferLo = buffers.lo[ index ].data();
+    float* bufferHi = buffers.hi[ index ].data();
+
+    if ( _order == 0 ) {
+        std::copy( bufferLo, bufferLo + numSamples, lo );
+        std::copy( bufferHi, bufferHi + numSamples, hi );
+        return;
+    }
+
+    // the octaves are processed in place (each output sample is written after its input samples were read),
+    // the last octave writes directly into the output
+
+    for ( int octave = _order - 1; octave >= 0; --octave ) {
+        const auto& design = octaves[ static_cast<size_t>( octave )];
+        Filter filter = _downsamplers[ static_cast<size_t>( octave )];
+
+        const int outSamples = numSamples << octave;
+
+        float* outLo = octave == 0 ? lo : bufferLo;
+        float* outHi = octave == 0 ? hi : bufferHi;
+
+        for ( int i = 0; i < outSamples; ++i ) {
+            Vector v { bufferLo[ i * 2 + 1 ], bufferLo[ i * 2 ], bufferHi[ i * 2 + 1 ], bufferHi[ i * 2 ] };
+            processStages( design, filter, v );
+
+            outLo[ i ] = 0.5f * ( v.lane[ 0 ] + v.lane[ 1 ]);
+            outHi[ i ] = 0.5f * ( v.lane[ 2 ] + v.lane[ 3 ]);
+        }
+        _downsamplers[ static_cast<size_t>( octave )] = filter;
+    }
+}
+
+void Oversampler::delay( float* channelData, int numSamples )
+{
+    if ( _latencySamples == 0 ) {
+        return;
+    }
+
+    for ( int i = 0; i < numSamples; ++i ) {
+        _delayLine[ _delayIndex ] = channelData[ i ];
+        channelData[ i ] = _delayLine[( _delayIndex - static_cast<size_t>( _latencySamples )) & ( DELAY_SIZE - 1 )];
+        _delayIndex = ( _delayIndex + 1 ) & ( DELAY_SIZE - 1 );
+    }
+}
+
+/* private methods */
+
+const std::array<Oversampler::Octave, Oversampler::MAX_ORDER>& Oversampler::getOctaves()
+{
+    static const std::array<Octave, MAX_ORDER> octaves = []
+    {
+        std::array<Octave, MAX_ORDER> designs {};
+
+        for ( size_t octave = 0; octave < designs.size(); ++octave ) {
+            const auto coefficients = designHalfBand( SPECIFICATIONS[ octave ]);
+            auto& design = designs[ octave ];
+
+            // coefficients alternate between the even and odd path, for both bands
+
+            design.numStages = static_cast<int>( coefficients.size() / 2 );
+
+            for ( size_t stage = 0; stage < static_cast<size_t>( design.numStages ); ++stage ) {
+                const auto even = static_cast<float>( coefficients[ stage * 2 ]);
+                const auto odd  = static_cast<float>( coefficients[ stage * 2 + 1 ]);
+
+                design.coefficients[ stage ] = { even, odd, even, odd };
+            }
+
+            // at DC each allpass section delays by ( 1 - c ) / ( 1 + c ) samples (at the lower rate), the
+            // round trip averages both paths twice while the sample offsets between the paths cancel out
+
+            for ( double c : coefficients ) {
+                design.latency += static_cast<float>(( 1.0 - c ) / ( 1.0 + c ));
+            }
+        }
+        return designs;
+    }(); // designed once, thread safe
+
+    return octaves;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <vector>
+
+/**
+ * Oversamples the low and high bands of a single channel by 2, 4 or 8 times, so the distortion
+ * can be applied at a higher sample rate (and the harmonics it generates above the host Nyquist
+ * frequency are filtered out instead of folding back into the audible range).
+ *
+ * Each octave is a polyphase half-band IIR filter (two parallel chains of first order allpass sections
+ * running at the lower rate of the octave), which for a similar stopband attenuation is considerably
+ * cheaper than a linear phase FIR. Both polyphase paths of both bands are computed side by side as four
+ * lanes, allowing the compiler to process them as a single SIMD vector. The octaves closer to the host
+ * rate use the steepest filters, the higher octaves only need to reject the images of the lower octaves.
+ *
+ * The filters are minimum phase, the latency reported by getLatency() is their group delay at DC.
+ */
+class Oversampler
+{
+    public:
+        static constexpr int MAX_ORDER = 3; // oversample by 2 ^ MAX_ORDER = 8 times at most
+
+        // scratch memory holding the oversampled bands, can be shared by all Oversamplers processed on the same thread
+
+        struct Buffers
+        {
+            std::array<std::vector<float>, 2> lo;
+            std::array<std::vector<float>, 2> hi;
+
+            void prepare( int maxBlockSize );
+        };
+
+        Oversampler();
+
+        // the oversampling factor is 2 ^ order (where 0 disables oversampling), the filter state is reset when changed
+        void setOrder( int order );
+        int getOrder() const { return _order; }
+        int getFactor() const { return 1 << _order; }
+
+        void reset();
+
+        /**
+         * Upsamples numSamples of both bands, returns the index of the pair of buffers (within
+         * buffers.lo and buffers.hi) holding the numSamples * getFactor() upsampled samples
+         */
+        size_t upsample( const float* lo, const float* hi, int numSamples, Buffers& buffers );
+
+        /**
+         * Downsamples the numSamples * getFactor() samples held by the pair of buffers at provided index
+         * (as returned by upsample()) back into numSamples of lo and hi. The contents of buffers are overwritten.
+         */
+        void downsample( Buffers& buffers, size_t index, float* lo, float* hi, int numSamples );
+
+        /**
+         * Delays provided signal by getLatencySamples(), to align signals that bypass the oversampling
+         * (e.g. the dry signal) with the oversampled signal
+         */
+        void delay( float* channelData, int numSamples );
+
+        // the latency of the round trip (up- and downsampling) at the current order, rounded to whole samples
+        int getLatencySamples() const { return _latencySamples; }
+
+        // the latency of the round trip at provided order, in samples at the host rate
+        static float getLatency( int order );
+
+    private:
+        static constexpr int LANES      = 4; // the polyphase paths of both bands, ordered as : lo even, lo odd, hi even, hi odd
+        static constexpr int MAX_STAGES = 4; // the maximum amount of allpass sections per path
+        static constexpr int DELAY_SIZE = 16; // exceeds the latency at MAX_ORDER, must be a power of two
+
+        struct alignas( 16 ) Vector
+        {
+            float lane[ LANES ];
+        };
+
+        // the state of a single half-band filter, x and y are the input and output history of each allpass section
+
+        struct Filter
+        {
+            std::array<Vector, MAX_STAGES> x;
+            std::array<Vector, MAX_STAGES> y;
+        };
+
+        // the design of the half-band filter of each octave (where octave 0 is the octave closest to the host rate)
+
+        struct Octave
+        {
+            int numStages = 0;
+            std::array<Vector, MAX_STAGES> coefficients;
+            float latency = 0.f; // of the round trip, in samples at the lower rate of the octave
+        };
+        static const std::array<Octave, MAX_ORDER>& getOctaves();
+
+        // runs a single sample of all lanes through the allpass sections of a filter, the fixed amount of lanes allows
+        // the compiler to process the inner loop as a single vector operation. The section output is written
+        // as c * v + x - c * y (rather than ( v - y ) * c + x) to shorten the dependency on the previous output
+
+        static inline void processStages( const Octave& octave, Filter& filter, Vector& v ) {
+            for ( size_t stage = 0; stage < static_cast<size_t>( octave.numStages ); ++stage ) {
+                const auto& c = octave.coefficients[ stage ];
+                auto& x = filter.x[ stage ];
+                auto& y = filter.y[ stage ];
+
+                for ( int lane = 0; lane < LANES; ++lane ) {
+                    const float out = c.lane[ lane ] * v.lane[ lane ] + x.lane[ lane ] - c.lane[ lane ] * y.lane[ lane ];
+
+                    x.lane[ lane ] = v.lane[ lane ];
+                    y.lane[ lane ] = out;
+                    v.lane[ lane ] = out;
+                }
+            }
+        }
+
+        int _order = 0;
+        int _latencySamples = 0;
+
+        std::array<Filter, MAX_ORDER> _upsamplers;
+        std::array<Filter, MAX_ORDER> _downsamplers;
+
+        std::array<float, DELAY_SIZE> _delayLine;
+        size_t _delayIndex = 0;
+};
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+
+/**
+ * The per-sample values of the parameters of a distortion module (the input level, drive and type specific
+ * parameter, as provided to its setters) during a block in which at least one of them is interpolating (see
+ * SmootherBank). When provided with ramps, modules compute their coefficients per sample, otherwise they
+ * use the values provided to their setters.
+ */
+struct ParameterRamps
+{
+    // the amount of samples over which modules that can't vary their coefficients per sample
+    // (e.g. anti-aliased curves, whose antiderivatives must match between samples) keep their coefficients
+
+    static constexpr size_t CHUNK_SIZE = 32;
+
+    const float* level = nullptr;
+    const float* drive = nullptr;
+    const float* param = nullptr;
+    int shift = 0; // each value spans 2 ^ shift samples (e.g. when processing an oversampled signal)
+
+    // the index of the value that applies to provided sample
+    inline size_t index( size_t sample ) const {
+        return sample >> shift;
+    }
+
+    // the ramps starting at provided value, for processing a block in parts
+    inline ParameterRamps from( size_t offset ) const {
+        return { level + offset, drive + offset, param + offset, shift };
+    }
+};
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SmootherBank.h"
+
+/* public methods */
+
+void SmootherBank::prepare( int numParameters, double sampleRate, float durationInSeconds, int maxBlockSize )
+{
+    jassert( numParameters <= MAX_PARAMETERS );
+
+    _numParameters = juce::jlimit( 0, MAX_PARAMETERS, numParameters );
+    _rampLength    = juce::jmax( 1, static_cast<int>( std::floor( sampleRate * durationInSeconds )));
+    _maxBlockSize  = static_cast<size_t>( juce::jmax( 1, maxBlockSize ));
+
+    _ramps.resize( static_cast<size_t>( _numParameters ) * _maxBlockSize );
+
+    for ( int index = 0; index < _numParameters; ++index ) {
+        setCurrentAndTarget( index, _requested[ static_cast<size_t>( index )].load());
+    }
+}
+
+void SmootherBank::setCurrentAndTarget( int index, float value )
+{
+    const auto i = static_cast<size_t>( index );
+
+    _requested[ i ].store( value );
+    _current[ i ]   = value;
+    _target[ i ]    = value;
+    _step[ i ]      = 0.f;
+    _remaining[ i ] = 0;
+    _smoothing[ i ] = false;
+
+    fillRamp( index, value );
+}
+
+void SmootherBank::set( int index, float value )
+{
+    _requested[ static_cast<size_t>( index )].store( value, std::memory_order_relaxed );
+}
+
+void SmootherBank::process( int numSamples )
+{
+    const int blockSize = juce::jmin( numSamples, static_cast<int>( _maxBlockSize ));
+
+    if ( blockSize <= 0 ) {
+        return;
+    }
+
+    for ( size_t i = 0; i < static_cast<size_t>( _numParameters ); ++i )
+    {
+        // pick up a changed target, which is reached after the ramp length (starting from the current value)
+
+        const float requested = _requested[ i ].load( std::memory_order_relaxed );
+
+        if ( requested != _target[ i ]) {
+            _target[ i ]    = requested;
+            _step[ i ]      = ( requested - _current[ i ]) / static_cast<float>( _rampLength );
+            _remaining[ i ] = _rampLength;
+        }
+        const bool wasSmoothing = _smoothing[ i ];
+        _smoothing[ i ] = _remaining[ i ] > 0;
+
+        if ( !_smoothing[ i ]) {
+            if ( wasSmoothing ) {
+                fillRamp( static_cast<int>( i ), _current[ i ]); // the ramp still holds the values of the final interpolated block
+            }
+            continue;
+        }
+
+        // each value is computed from the value at the start of the block (rather than accumulated)
+        // so the loop vectorizes, once the target is reached the remainder of the block holds the target
+
+        float* ramp = _ramps.data() + i * _maxBlockSize;
+        const float start = _current[ i ];
+        const float step  = _step[ i ];
+        const int rampSamples = juce::jmin( blockSize, _remaining[ i ]);
+
+        for ( int sample = 0; sample < rampSamples; ++sample ) {
+            ramp[ sample ] = start + step * static_cast<float>( sample + 1 );
+        }
+        _remaining[ i ] -= rampSamples;
+
+        if ( _remaining[ i ] == 0 ) {
+            _current[ i ] = _target[ i ];
+            std::fill( ramp + rampSamples, ramp + blockSize, _target[ i ]);
+        } else {
+            _current[ i ] = ramp[ rampSamples - 1 ];
+        }
+    }
+}
+
+bool SmootherBank::isSmoothing( int first, int last ) const
+{
+    for ( int index = first; index <= last; ++index ) {
+        if ( isSmoothing( index )) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* private methods */
+
+void SmootherBank::fillRamp( int index, float value )
+{
+    float* ramp = _ramps.data() + static_cast<size_t>( index ) * _maxBlockSize;
+    std::fill( ramp, ramp + _maxBlockSize, value );
+}
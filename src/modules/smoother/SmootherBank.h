@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * Linearly interpolates a set of parameter values over a fixed duration, to overcome the audible
+ * glitches ("zipper noise") of changing them directly.
+ *
+ * The state of all parameters is stored as a structure of arrays. Once per block, process() renders
+ * the per-sample values of all interpolating parameters into their ramps (a single pass in which each
+ * ramp is a vectorizable loop), parameters that aren't interpolating cost only a comparison.
+ */
+class SmootherBank
+{
+    public:
+        static constexpr int MAX_PARAMETERS = 32;
+
+        /**
+         * Sets the amount of parameters, the interpolation duration and allocates the ramps to hold blocks
+         * of up to maxBlockSize samples. The current values are kept. Should not be invoked during processing.
+         */
+        void prepare( int numParameters, double sampleRate, float durationInSeconds, int maxBlockSize );
+
+        // sets the value of a parameter immediately (e.g. without interpolation), not to be invoked during processing
+        void setCurrentAndTarget( int index, float value );
+
+        // sets the value a parameter will be interpolated to, can be invoked from any
+        // thread (the new target is picked up by the next process() call)
+        void set( int index, float value );
+
+        // advances all parameters by numSamples (up to maxBlockSize), writing the ramps of the parameters that are interpolating
+        void process( int numSamples );
+
+        // whether provided parameter was interpolating during the last process() call
+        bool isSmoothing( int index ) const {
+            return _smoothing[ static_cast<size_t>( index )];
+        }
+
+        // whether any of the parameters in the [ first, last ] range was interpolating during the last process() call
+        bool isSmoothing( int first, int last ) const;
+
+        // the value of a parameter at the end of the last processed block
+        float get( int index ) const {
+            return _current[ static_cast<size_t>( index )];
+        }
+
+        // the per-sample values of a parameter during the last processed block (for a parameter
+        // that wasn't interpolating, each sample equals its current value)
+        const float* getRamp( int index ) const {
+            return _ramps.data() + static_cast<size_t>( index ) * _maxBlockSize;
+        }
+
+    private:
+        int _numParameters = 0;
+        int _rampLength    = 1; // in samples
+        size_t _maxBlockSize = 0;
+
+        std::array<float, MAX_PARAMETERS> _current {};
+        std::array<float, MAX_PARAMETERS> _target {};
+        std::array<float, MAX_PARAMETERS> _step {};
+        std::array<int,   MAX_PARAMETERS> _remaining {}; // amount of samples until the target is reached
+        std::array<bool,  MAX_PARAMETERS> _smoothing {};
+        std::array<std::atomic<float>, MAX_PARAMETERS> _requested {}; // the targets as set by set()
+
+        std::vector<float> _ramps; // _maxBlockSize values per parameter
+
+        void fillRamp( int index, float value );
+};
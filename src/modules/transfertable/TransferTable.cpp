@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TransferTable.h"
+#include <thread>
+
+// interval (in milliseconds) at which the builder thread checks for stale tables when idle
+
+static constexpr int IDLE_INTERVAL = 10;
+
+/* constructor / destructor */
+
+TransferTable::TransferTable( Renderer curveRenderer ) : renderer( std::move( curveRenderer ))
+{
+    builder->addTimeSliceClient( this );
+}
+
+TransferTable::~TransferTable()
+{
+    builder->removeTimeSliceClient( this );
+}
+
+/* public methods */
+
+void TransferTable::setEnabled( bool value )
+{
+    enabled.store( value );
+}
+
+void TransferTable::setSynchronous( bool value )
+{
+    synchronous.store( value );
+}
+
+void TransferTable::invalidate()
+{
+    requestedVersion.fetch_add( 1, std::memory_order_release );
+}
+
+void TransferTable::update()
+{
+    if ( !enabled.load( std::memory_order_relaxed )) {
+        current = nullptr;
+        return;
+    }
+    const juce::uint32 version = requestedVersion.load( std::memory_order_acquire );
+
+    // when synchronous, the table must match the current parameters. The builder thread might still be rendering
+    // a table it started on before switching to synchronous mode, in which case its build is awaited (rather than
+    // skipping the rebuild and processing this block without a table, which would make the output non-deterministic)
+
+    if ( synchronous.load( std::memory_order_relaxed ) && builtVersion.load( std::memory_order_relaxed ) != version ) {
+        while ( !build()) {
+            std::this_thread::yield();
+        }
+    }
+    tables.update();
+
+    const auto& table = tables.getReadBuffer();
+
+    // a table rendered for a previous version does not match the current parameters
+
+    current = table.version == version ? table.points.data() : nullptr;
+}
+
+/* private methods */
+
+bool TransferTable::build()
+{
+    // only one thread can produce a table at a time (when switching between
+    // synchronous and asynchronous building, both threads could attempt to do so)
+
+    if ( building.exchange( true, std::memory_order_acquire )) {
+        return false;
+    }
+
+    // the version is read before rendering : when a parameter changes while rendering, the table is
+    // published under an outdated version (and thus ignored) and rebuilt on the next attempt
+
+    const juce::uint32 version = requestedVersion.load( std::memory_order_acquire );
+    auto& table = tables.getWriteBuffer();
+
+    renderer( table.points.data(), SIZE + 1 );
+    table.version = version;
+
+    tables.publish();
+    builtVersion.store( version, std::memory_order_relaxed );
+
+    building.store( false, std::memory_order_release );
+
+    return true;
+}
+
+int TransferTable::useTimeSlice()
+{
+    const bool isStale = builtVersion.load( std::memory_order_relaxed ) != requestedVersion.load( std::memory_order_relaxed );
+
+    if ( isStale && enabled.load() && !synchronous.load()) {
+        build();
+        return 1; // check again shortly in case parameters are still changing
+    }
+    return IDLE_INTERVAL;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "../../utils/BackgroundThread.h"
+#include "../../utils/TripleBuffer.h"
+
+/**
+ * A finely sampled, precomputed transfer curve for memoryless (waveshaping) modules.
+ *
+ * Whenever a parameter affecting the curve changes, the owning module calls invalidate() and
+ * the table is rebuilt on the shared BackgroundThread, after which it is published to the audio
+ * thread without locking (and picked up on the next update()). Until the rebuilt table is available,
+ * acquire() returns nullptr and the module should compute its curve directly. This keeps the output correct during parameter ramps
+ * while static settings are processed as an interpolated table read.
+ */
+class TransferTable : private juce::TimeSliceClient
+{
+    public:
+        static constexpr int SIZE = 2048; // amount of segments, the table holds SIZE + 1 points
+
+        /**
+         * Renders the curve into provided table of SIZE + 1 points, where point n corresponds
+         * to position n / SIZE. Invoked on the builder thread (or on the audio thread when synchronous)
+         */
+        using Renderer = std::function<void( float* table, int numPoints )>;
+
+        explicit TransferTable( Renderer renderer );
+        ~TransferTable() override;
+
+        // whether tables are used at all (when false, acquire() always returns nullptr)
+        void setEnabled( bool enabled );
+
+        // when true, stale tables are rebuilt on the next update() call on the calling thread instead of on the
+        // background thread (awaiting a build still in progress there). This is slower during parameter changes
+        // but guarantees deterministic output (offline rendering)
+        void setSynchronous( bool synchronous );
+
+        // to be invoked after a parameter affecting the curve has changed
+        void invalidate();
+
+        // picks up the most recently built table, to be invoked by the audio thread once per block (before processing)
+        void update();
+
+        // returns the table matching the parameters at the last update() call or nullptr when there is none (yet).
+        // Can be invoked concurrently by multiple threads (e.g. when processing channels in parallel)
+        const float* acquire() const { return current; }
+
+        /**
+         * Reads the table at provided position within the 0 - 1 range (values outside
+         * of this range are clamped), linearly interpolating between neighbouring points
+         */
+        static inline float lookup( const float* table, float position ) {
+            const float index = juce::jlimit( 0.f, 1.f, position ) * static_cast<float>( SIZE );
+            const int   whole = juce::jmin( static_cast<int>( index ), SIZE - 1 );
+            const float fraction = index - static_cast<float>( whole );
+
+            return table[ whole ] + fraction * ( table[ whole + 1 ] - table[ whole ]);
+        }
+
+    private:
+        struct Table
+        {
+            std::array<float, SIZE + 1> points;
+            juce::uint32 version = 0;
+        };
+
+        Renderer renderer;
+        TripleBuffer<Table> tables;
+        const float* current = nullptr;
+        juce::SharedResourcePointer<BackgroundThread> builder;
+
+        std::atomic<juce::uint32> requestedVersion { 1 }; // tables are initially at version 0 (e.g. stale)
+        std::atomic<juce::uint32> builtVersion { 0 };
+        std::atomic<bool> building { false }; // guards the producer side of the tables
+        std::atomic<bool> enabled { true };
+        std::atomic<bool> synchronous { false };
+
+        bool build();
+        int useTimeSlice() override;
+};
@@ -20,7 +20,7 @@
 
 // constructor
 
-WaveFolder::WaveFolder()
+WaveFolder::WaveFolder() : _table([ this ]( float* table, int numPoints ) { renderTable( table, numPoints ); })
 {
     setLevel( Parameters::Config::DIST_INPUT_DEF );
     setDrive( Parameters::Config::DIST_DRIVE_DEF );
@@ -32,27 +32,77 @@ WaveFolder::WaveFolder()
 
 void WaveFolder::apply( float* channelData, unsigned long bufferSize )
 {
-    float foldAmount = juce::jmax( 0.001f, _threshold / _fold );
-    float range = FOLDING_MULTIPLIER * foldAmount;
-    
-    for ( size_t i = 0; i < bufferSize; ++i )
-    {
-        float inputSample = channelData[ i ] * _level;
+    if ( const float* table = _table.acquire()) {
+        applyTable( table, channelData, bufferSize );
+        return;
+    }
+
+    float foldAmount = getFoldAmount();
+
+    // fold the signal over itself whenever it exceeds the fold amount (within a range of twice the fold amount)
+
+    MathUtilities::applyTriangleFold( channelData, bufferSize, _level, foldAmount );
+
+    // apply drive to the folded signal (normalized so full scale input remains at full scale)
+
+    MathUtilities::applyTanh( channelData, bufferSize, _drive.load(), _driveNormalisation.load());
+}
 
-        float wrapped = std::fmod( inputSample + foldAmount, range );
-        if ( wrapped < 0.0f ) {
-            wrapped += range;
+void WaveFolder::apply( float* channelData, unsigned long bufferSize, AntiAliasing::State& state, const ParameterRamps* ramps )
+{
+    const bool antiAliasing = _antiAliasing.load() != AntiAliasing::Order::Off;
+
+    if ( ramps == nullptr ) {
+        if ( antiAliasing ) {
+            applyAntiAliased( channelData, bufferSize, state, getFoldAmount(), _drive.load(), _driveNormalisation.load(), _level );
+        } else {
+            state.push( channelData, bufferSize );
+            apply( channelData, bufferSize );
         }
-        float folded = std::abs( wrapped - foldAmount ) - foldAmount;
+        return;
+    }
 
-        // apply drive to the folded signal
+    if ( !antiAliasing ) {
+        state.push( channelData, bufferSize );
+        applyRamped( channelData, bufferSize, *ramps );
+        return;
+    }
 
-        float outputSample = std::tanh( folded * _drive ) / std::tanh( _drive );
+    // the anti-aliased curve follows the ramps in chunks (see ParameterRamps::CHUNK_SIZE)
 
-        channelData[ i ] = outputSample;
+    for ( size_t offset = 0; offset < bufferSize; offset += ParameterRamps::CHUNK_SIZE )
+    {
+        const size_t index = ramps->index( offset );
+        const float drive  = getDrive( ramps->drive[ index ]);
+
+        applyAntiAliased(
+            channelData + offset, static_cast<unsigned long>( std::min<size_t>( ParameterRamps::CHUNK_SIZE, bufferSize - offset )), state,
+            juce::jmax( 0.001f, getThreshold( ramps->param[ index ]) / getFold( ramps->drive[ index ])),
+            drive, 1.0 / std::tanh( drive ), ramps->level[ index ]
+        );
     }
 }
 
+void WaveFolder::setAntiAliasing( AntiAliasing::Order order )
+{
+    _antiAliasing.store( order );
+}
+
+void WaveFolder::setLookupTableEnabled( bool enabled )
+{
+    _table.setEnabled( enabled );
+}
+
+void WaveFolder::setLookupTableSynchronous( bool synchronous )
+{
+    _table.setSynchronous( synchronous );
+}
+
+void WaveFolder::updateLookupTable()
+{
+    _table.update();
+}
+
 /* setters */
 
 void WaveFolder::setLevel( float value )
@@ -63,18 +113,122 @@ void WaveFolder::setLevel( float value )
 void WaveFolder::setDrive( float value )
 {
     // we control both fold and drive with a single value
-    _fold  = FOLD_MIN + std::pow( value, 1.8f ) * ( FOLD_MAX - FOLD_MIN );
-    _drive = DRIVE_MIN + std::pow( value, 2.2f ) * ( DRIVE_MAX  - DRIVE_MIN );
+    const float drive = getDrive( value );
+
+    if ( drive == _drive.load()) {
+        return;
+    }
+    _fold.store( getFold( value ));
+    _drive.store( drive );
+    _driveNormalisation.store( 1.f / std::tanh( drive ));
+
+    _table.invalidate();
 }
 
 void WaveFolder::setThreshold( float value )
 {
-    _threshold = juce::jmap(
-        MathUtilities::inverseNormalize( value ), 0.1f, 0.5f
-    );
+    const float threshold = getThreshold( value );
+    if ( threshold != _threshold.exchange( threshold )) {
+        _table.invalidate();
+    }
 }
 
 // void WaveFolder::setThresholdNegative( float value )
 // {
 //     _thresholdNegative = value;
 // }
+
+/* private methods */
+
+void WaveFolder::applyTable( const float* table, float* channelData, unsigned long bufferSize )
+{
+    // determine the position of each sample within the fold period (see MathUtilities::triangleFold())
+
+    const float foldAmount   = getFoldAmount();
+    const float level        = _level;
+    const float inverseRange = 1.f / ( 2.f * foldAmount );
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const float shifted = ( channelData[ i ] * level + foldAmount ) * inverseRange;
+        channelData[ i ] = TransferTable::lookup( table, shifted - MathUtilities::fastFloor( shifted ));
+    }
+}
+
+void WaveFolder::applyAntiAliased(
+    float* channelData, unsigned long bufferSize, AntiAliasing::State& state,
+    double foldAmount, double drive, double normalisation, float level
+) {
+    // the curve is expressed in terms of the position within the fold period (of size 2a), where the folded
+    // signal equals -position for the first half and position - 2a for the second half of the period
+
+    const double a = foldAmount;
+    const double d = drive;
+    const double range = 2.0 * a;
+
+    auto fold = [ a, range ]( double value, double& periods ) {
+        periods = std::floor(( value + a ) / range );
+        return value + a - periods * range; // position within the period
+    };
+
+    auto function = [ a, d, normalisation, fold ]( double value ) {
+        double periods;
+        const double position = fold( value, periods );
+        const double folded = position <= a ? -position : position - 2.0 * a;
+
+        return std::tanh( d * folded ) * normalisation;
+    };
+
+    // the antiderivative of tanh( d * x ) is log( cosh( d * x )) / d, the integral
+    // over each full period is equal and accumulated for each period passed
+
+    const double halfPeriodIntegral = -logCosh( d * a ) / d;
+    const double periodIntegral     = 2.0 * halfPeriodIntegral;
+
+    auto integral = [ a, d, normalisation, fold, halfPeriodIntegral, periodIntegral ]( double value ) {
+        double periods;
+        const double position = fold( value, periods );
+
+        const double partial = position <= a
+            ? -logCosh( d * position ) / d
+            : halfPeriodIntegral + ( logCosh( d * ( position - 2.0 * a )) - logCosh( d * a )) / d;
+
+        return ( periods * periodIntegral + partial ) * normalisation;
+    };
+
+    AntiAliasing::applyFirstOrder( channelData, bufferSize, state, level, function, integral );
+}
+
+void WaveFolder::applyRamped( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps )
+{
+    // equal to the direct path of apply(), with the coefficients computed per sample (see setDrive() and setThreshold())
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const size_t index = ramps.index( i );
+
+        const float value      = ramps.drive[ index ];
+        const float drive      = DRIVE_MIN + MathUtilities::fastPow( value, 2.2f ) * ( DRIVE_MAX - DRIVE_MIN );
+        const float fold       = FOLD_MIN + MathUtilities::fastPow( value, 1.8f ) * ( FOLD_MAX - FOLD_MIN );
+        const float foldAmount = std::max( 0.001f, getThreshold( ramps.param[ index ]) / fold );
+
+        const float folded = MathUtilities::triangleFold( channelData[ i ] * ramps.level[ index ], foldAmount, 1.f / ( 2.f * foldAmount ));
+
+        channelData[ i ] = MathUtilities::fastTanh( folded * drive ) / MathUtilities::fastTanh( drive );
+    }
+}
+
+void WaveFolder::renderTable( float* table, int numPoints )
+{
+    const float foldAmount    = getFoldAmount();
+    const float drive         = _drive.load();
+    const float normalisation = _driveNormalisation.load();
+
+    for ( int i = 0; i < numPoints; ++i )
+    {
+        const float phase  = static_cast<float>( i ) / static_cast<float>( numPoints - 1 );
+        const float folded = foldAmount * ( std::abs( 2.f * phase - 1.f ) - 1.f );
+
+        table[ i ] = std::tanh( folded * drive ) * normalisation;
+    }
+}
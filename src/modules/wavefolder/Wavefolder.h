@@ -17,6 +17,9 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../antialiasing/AntiAliasing.h"
+#include "../smoother/ParameterRamps.h"
+#include "../transfertable/TransferTable.h"
 
 class WaveFolder
 {
@@ -33,19 +36,67 @@ class WaveFolder
         
         void apply( float* channelData, unsigned long bufferSize );
 
+        // applies the folding with anti-aliasing (when enabled), using provided history of the processed signal
+        // and the per-sample parameter values provided by ramps (when not nullptr)
+        void apply( float* channelData, unsigned long bufferSize, AntiAliasing::State& state, const ParameterRamps* ramps = nullptr );
+
+        // the second antiderivative of the driven fold has no closed form, second order falls back to first order
+        void setAntiAliasing( AntiAliasing::Order order );
+
+        // see TransferTable
+        void setLookupTableEnabled( bool enabled );
+        void setLookupTableSynchronous( bool synchronous );
+        void updateLookupTable();
+
     private:
         // amount of times we fold the waveform over itself
         // when it exceeds the threshold (increases harmonic complexity)
 
-        static constexpr float FOLDING_MULTIPLIER = 2.0f;
         static float constexpr FOLD_MIN  = 1.f;
         static float constexpr FOLD_MAX  = 10.f;
         static float constexpr DRIVE_MIN = 1.f;
         static float constexpr DRIVE_MAX = 5.f;
 
         float _level;
-        float _drive;
-        float _fold;
-        float _threshold;
+        std::atomic<float> _drive { DRIVE_MIN };
+        std::atomic<float> _driveNormalisation { 1.f }; // 1 / tanh( _drive )
+        std::atomic<float> _fold { FOLD_MIN };
+        std::atomic<float> _threshold { 0.5f };
+        std::atomic<AntiAliasing::Order> _antiAliasing { AntiAliasing::Order::Off };
         // float _thresholdNegative;
+
+        // the transfer table holds a single period of the folded (and driven) waveform, which
+        // is identical for all input values, only the position within the period differs
+
+        TransferTable _table; // declared last as its renderer refers to the members above
+
+        inline float getFoldAmount() const {
+            return juce::jmax( 0.001f, _threshold.load() / _fold.load());
+        }
+        void applyTable( const float* table, float* channelData, unsigned long bufferSize );
+        void applyRamped( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps );
+        void applyAntiAliased(
+            float* channelData, unsigned long bufferSize, AntiAliasing::State& state,
+            double foldAmount, double drive, double normalisation, float level
+        );
+        void renderTable( float* table, int numPoints );
+
+        // the curve coefficients for provided (normalized) drive and threshold, see setDrive() and setThreshold()
+        static inline float getDrive( float value ) {
+            return DRIVE_MIN + std::pow( value, 2.2f ) * ( DRIVE_MAX - DRIVE_MIN );
+        }
+
+        static inline float getFold( float value ) {
+            return FOLD_MIN + std::pow( value, 1.8f ) * ( FOLD_MAX - FOLD_MIN );
+        }
+
+        static inline float getThreshold( float value ) {
+            return juce::jmap( 1.f - value, 0.1f, 0.5f );
+        }
+
+        // log( cosh( value )), without overflowing for large values
+        static inline double logCosh( double value ) {
+            const double magnitude = std::abs( value );
+            return magnitude + std::log1p( std::exp( -2.0 * magnitude )) - 0.69314718055994531; // ln( 2 )
+        }
 };
@@ -21,7 +21,7 @@
 
 // constructor
 
-WaveShaper::WaveShaper()
+WaveShaper::WaveShaper() : _table([ this ]( float* table, int numPoints ) { renderTable( table, numPoints ); })
 {
     setAmount( Parameters::Config::DIST_DRIVE_DEF );
     setShape( Parameters::Config::DIST_PARAM_DEF );
@@ -32,33 +32,135 @@ WaveShaper::WaveShaper()
 
 void WaveShaper::apply( float* channelData, unsigned long bufferSize )
 {
-    for ( size_t i = 0; i < bufferSize; ++i )
-    {
-        auto input = channelData[ i ];
-        
-        float sign = std::copysign( 1.0f, input );
-        input = sign * std::pow( std::abs( input ), _shape );
-
-        float shaped = (( 1.0f + _multiplier ) * input ) / ( 1.0f + _multiplier * std::abs( input ));
+    if ( const float* table = _table.acquire()) {
+        applyTable( table, channelData, bufferSize );
+    } else {
+        applyDirect( channelData, bufferSize );
+    }
+}
 
-        channelData[ i ] = shaped * _level;
+void WaveShaper::apply( float* channelData, unsigned long bufferSize, const ParameterRamps* ramps )
+{
+    if ( ramps != nullptr ) {
+        applyRamped( channelData, bufferSize, *ramps );
+    } else {
+        apply( channelData, bufferSize );
     }
 }
 
+void WaveShaper::setLookupTableEnabled( bool enabled )
+{
+    _table.setEnabled( enabled );
+}
+
+void WaveShaper::setLookupTableSynchronous( bool synchronous )
+{
+    _table.setSynchronous( synchronous );
+}
+
+void WaveShaper::updateLookupTable()
+{
+    _table.update();
+}
+
 /* setters */
 
 void WaveShaper::setAmount( float value )
 {
-    _amount     = value;
-    _multiplier = 2.0f * _amount / ( 1.0f - fmin( 0.99999f, _amount ));
+    if ( value == _amount ) {
+        return;
+    }
+    _amount = value;
+    _multiplier.store( 2.0f * _amount / ( 1.0f - fmin( 0.99999f, _amount )));
+    _table.invalidate();
 }
 
 void WaveShaper::setShape( float value )
 {
-    _shape = juce::jmap( MathUtilities::inverseNormalize( value ), 0.25f, 4.0f );   
+    const float shape = juce::jmap( MathUtilities::inverseNormalize( value ), 0.25f, 4.0f );
+
+    if ( shape != _shape.exchange( shape )) {
+        _table.invalidate();
+    }
 }
 
 void WaveShaper::setOutputLevel( float value )
 {
     _level = value;
 }
+
+/* private methods */
+
+void WaveShaper::applyDirect( float* channelData, unsigned long bufferSize )
+{
+    // apply the shape curve (sign preserving pow) using the vectorized kernel
+
+    MathUtilities::applySignedPow( channelData, bufferSize, _shape.load());
+
+    // and saturate (kept in locals so the compiler knows these don't alias channelData)
+
+    const float multiplier = _multiplier.load();
+    const float gain  = 1.0f + multiplier;
+    const float level = _level;
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const float input = channelData[ i ];
+        const float shaped = ( gain * input ) / ( 1.0f + multiplier * std::abs( input ));
+
+        channelData[ i ] = shaped * level;
+    }
+}
+
+void WaveShaper::applyTable( const float* table, float* channelData, unsigned long bufferSize )
+{
+    const float shape      = _shape.load();
+    const float multiplier = _multiplier.load();
+    const float level      = _level;
+    const float positionScale = 1.0f / TABLE_MAX_POSITION;
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const float input     = channelData[ i ];
+        const float magnitude = std::abs( input );
+
+        const float shaped = magnitude > TABLE_MAX_INPUT
+            ? shapeMagnitude( magnitude, shape, multiplier )
+            : TransferTable::lookup( table, std::sqrt( std::sqrt( magnitude )) * positionScale );
+
+        channelData[ i ] = ( input < 0.0f ? -shaped : shaped ) * level;
+    }
+}
+
+void WaveShaper::applyRamped( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps )
+{
+    // equal to applyDirect(), with the coefficients computed per sample (see setAmount() and setShape())
+
+    for ( size_t i = 0; i < bufferSize; ++i )
+    {
+        const size_t index = ramps.index( i );
+
+        const float amount     = ramps.drive[ index ];
+        const float multiplier = 2.0f * amount / ( 1.0f - std::min( 0.99999f, amount ));
+        const float shape      = juce::jmap( MathUtilities::inverseNormalize( ramps.param[ index ]), 0.25f, 4.0f );
+
+        const float input  = MathUtilities::fastSignedPow( channelData[ i ], shape );
+        const float shaped = (( 1.0f + multiplier ) * input ) / ( 1.0f + multiplier * std::abs( input ));
+
+        channelData[ i ] = shaped * ramps.level[ index ];
+    }
+}
+
+void WaveShaper::renderTable( float* table, int numPoints )
+{
+    const float shape      = _shape.load();
+    const float multiplier = _multiplier.load();
+
+    for ( int i = 0; i < numPoints; ++i )
+    {
+        const float position = TABLE_MAX_POSITION * static_cast<float>( i ) / static_cast<float>( numPoints - 1 );
+        const float squared  = position * position;
+
+        table[ i ] = shapeMagnitude( squared * squared, shape, multiplier );
+    }
+}
@@ -16,6 +16,11 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cmath>
+#include "../smoother/ParameterRamps.h"
+#include "../transfertable/TransferTable.h"
+
 class WaveShaper
 {
     public:
@@ -26,9 +31,37 @@ class WaveShaper
         void setOutputLevel( float value );
         void apply( float* channelData, unsigned long bufferSize );
 
+        // applies the shaping using the per-sample parameter values provided by ramps (when not nullptr)
+        void apply( float* channelData, unsigned long bufferSize, const ParameterRamps* ramps );
+
+        // see TransferTable
+        void setLookupTableEnabled( bool enabled );
+        void setLookupTableSynchronous( bool synchronous );
+        void updateLookupTable();
+
     private:
-        float _amount;
-        float _shape;
-        float _multiplier;
+        // the transfer table covers inputs up to this magnitude (louder samples are computed directly)
+        // the table is indexed by the fourth root of the input magnitude, which keeps the steep
+        // slope of the shape curve near the origin (for small shape values) well sampled
+
+        static constexpr float TABLE_MAX_INPUT    = 4.f;
+        static constexpr float TABLE_MAX_POSITION = 1.41421356f; // TABLE_MAX_INPUT ^ 0.25
+
+        float _amount = -1.f; // invalid, so the first setAmount() call applies
+        std::atomic<float> _shape { 1.f };
+        std::atomic<float> _multiplier { 0.f };
         float _level;
+
+        TransferTable _table; // declared last as its renderer refers to the members above
+
+        void applyDirect( float* channelData, unsigned long bufferSize );
+        void applyTable( const float* table, float* channelData, unsigned long bufferSize );
+        void applyRamped( float* channelData, unsigned long bufferSize, const ParameterRamps& ramps );
+        void renderTable( float* table, int numPoints );
+
+        // the shaping curve for a positive input value
+        static inline float shapeMagnitude( float magnitude, float shape, float multiplier ) {
+            const float shaped = std::pow( magnitude, shape );
+            return (( 1.0f + multiplier ) * shaped ) / ( 1.0f + multiplier * shaped );
+        }
 };
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "../Parameters.h"
+#include "../modules/modulation/ModulationMatrix.h"
+#include <vector>
+
+/**
+ * The presets shipped with the plugin, listed before the user presets. Each preset only lists the (unnormalised)
+ * values that differ from the defaults of the parameter layout. These are parsed into snapshots once, when the
+ * PresetBank is created.
+ */
+namespace FactoryPresets {
+    struct Value {
+        juce::String id;
+        float value;
+    };
+
+    struct Preset {
+        juce::String name;
+        std::vector<Value> values;
+    };
+
+    static constexpr float WAVESHAPER  = static_cast<float>( Parameters::DistortionType::WaveShaper );
+    static constexpr float WAVEFOLDER  = static_cast<float>( Parameters::DistortionType::WaveFolder );
+    static constexpr float FUZZ        = static_cast<float>( Parameters::DistortionType::Fuzz );
+    static constexpr float BIT_CRUSHER = static_cast<float>( Parameters::DistortionType::BitCrusher );
+    static constexpr float HARMONIC    = static_cast<float>( Parameters::SplitMode::Harmonic );
+    static constexpr float LFO_1       = static_cast<float>( ModulationMatrix::Source::LFO1 );
+    static constexpr float ENVELOPE    = static_cast<float>( ModulationMatrix::Source::Envelope );
+    static constexpr float SPLIT_FREQ_TARGET = static_cast<float>( ModulationMatrix::SplitFrequency );
+    static constexpr float HI_PARAM_TARGET   = static_cast<float>( ModulationMatrix::getParamTarget( Parameters::MAX_BANDS - 1 ));
+
+    static const std::vector<Preset> PRESETS = {
+        { "Init", {}},
+        { "Warm low end", {
+            { Parameters::SPLIT_FREQ,    180.f },
+            { Parameters::LO_DIST_DRIVE, 0.35f },
+            { Parameters::LO_DIST_PARAM, 0.4f },
+            { Parameters::HI_DIST_TYPE,  0.f },
+            { Parameters::DRY_WET_MIX,   0.6f }
+        }},
+        { "Crushed highs", {
+            { Parameters::SPLIT_FREQ,    2500.f },
+            { Parameters::LO_DIST_TYPE,  0.f },
+            { Parameters::HI_DIST_TYPE,  BIT_CRUSHER },
+            { Parameters::HI_DIST_DRIVE, 0.6f },
+            { Parameters::HI_DIST_PARAM, 0.3f }
+        }},
+        { "Fuzzed harmonics", {
+            { Parameters::SPLIT_MODE,       HARMONIC },
+            { Parameters::HARMONIC_COUNT,   8.f },
+            { Parameters::HARMONIC_WIDTH,   0.2f },
+            { Parameters::LO_DIST_TYPE,     FUZZ },
+            { Parameters::LO_DIST_DRIVE,    0.7f },
+            { Parameters::HI_DIST_TYPE,     0.f }
+        }},
+        { "Folded residue", {
+            { Parameters::SPLIT_MODE,       HARMONIC },
+            { Parameters::HARMONIC_FALLOFF, 0.5f },
+            { Parameters::LO_DIST_TYPE,     0.f },
+            { Parameters::HI_DIST_TYPE,     WAVEFOLDER },
+            { Parameters::HI_DIST_DRIVE,    0.65f }
+        }},
+        { "Three band grit", {
+            { Parameters::BAND_COUNT,      3.f },
+            { Parameters::SPLIT_FREQ,      200.f },
+            { Parameters::SPLIT_FREQ_2,    3000.f },
+            { Parameters::LO_DIST_DRIVE,   0.3f },
+            { Parameters::MID1_DIST_TYPE,  FUZZ },
+            { Parameters::MID1_DIST_DRIVE, 0.55f },
+            { Parameters::HI_DIST_TYPE,    WAVESHAPER },
+            { Parameters::HI_DIST_DRIVE,   0.4f }
+        }},
+        { "Five band spread", {
+            { Parameters::BAND_COUNT,      5.f },
+            { Parameters::SPLIT_FREQ,      120.f },
+            { Parameters::SPLIT_FREQ_2,    600.f },
+            { Parameters::SPLIT_FREQ_3,    2400.f },
+            { Parameters::SPLIT_FREQ_4,    7000.f },
+            { Parameters::MID1_DIST_TYPE,  WAVEFOLDER },
+            { Parameters::MID2_DIST_TYPE,  FUZZ },
+            { Parameters::MID3_DIST_TYPE,  BIT_CRUSHER },
+            { Parameters::MID3_DIST_PARAM, 0.5f },
+            { Parameters::DRY_WET_MIX,     0.75f }
+        }},
+        { "Swept split", {
+            { Parameters::SPLIT_FREQ,     400.f },
+            { Parameters::LO_DIST_TYPE,   0.f },
+            { Parameters::HI_DIST_TYPE,   FUZZ },
+            { Parameters::HI_DIST_DRIVE,  0.5f },
+            { Parameters::MOD1_SOURCE,    LFO_1 },
+            { Parameters::MOD1_TARGET,    SPLIT_FREQ_TARGET },
+            { Parameters::MOD1_DEPTH,     0.75f },
+            { Parameters::MOD2_SOURCE,    ENVELOPE },
+            { Parameters::MOD2_TARGET,    HI_PARAM_TARGET },
+            { Parameters::MOD2_DEPTH,     0.4f }
+        }}
+    };
+}
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PresetBank.h"
+#include "FactoryPresets.h"
+#include <algorithm>
+
+// the header of the user preset file, followed by the format version
+
+static constexpr int FILE_ID      = 0x50524850; // "PHRP" (little endian)
+static constexpr int FILE_VERSION = 2;
+
+// identifies a user preset across the instances sharing the preset file (0 is reserved for the factory presets)
+
+static juce::int64 createPresetId()
+{
+    juce::int64 id = 0;
+
+    while ( id == 0 ) {
+        id = juce::Random::getSystemRandom().nextInt64();
+    }
+    return id;
+}
+
+/* constructor */
+
+PresetBank::PresetBank( juce::AudioProcessorValueTreeState& vts ) : valueTreeState( vts )
+{
+    for ( auto* parameter : valueTreeState.processor.getParameters()) {
+        jassert( parameter->getParameterIndex() < MAX_PARAMETERS );
+        auto* rangedParameter = dynamic_cast<juce::RangedAudioParameter*>( parameter );
+
+        rawValues[ static_cast<size_t>( layout.size())] = valueTreeState.getRawParameterValue( rangedParameter->getParameterID());
+        layout.add( rangedParameter );
+    }
+
+    // the factory presets are parsed once, resolving their parameter IDs into indices of the snapshot
+
+    for ( const auto& preset : FactoryPresets::PRESETS ) {
+        auto snapshot = createDefaultSnapshot();
+
+        for ( const auto& value : preset.values ) {
+            if ( auto* parameter = valueTreeState.getParameter( value.id )) {
+                snapshot[ static_cast<size_t>( parameter->getParameterIndex())] = parameter->convertTo0to1( value.value );
+            }
+        }
+        add( preset.name, snapshot, 0 );
+    }
+    numFactoryPresets = names.size();
+
+    publish();
+}
+
+PresetBank::~PresetBank()
+{
+    cancelPendingUpdate();
+}
+
+/* public methods */
+
+bool PresetBank::setName( int index, const juce::String& name )
+{
+    if ( index < numFactoryPresets || index >= names.size() || name.isEmpty()) {
+        return false;
+    }
+    names.set( index, name );
+    modified[ static_cast<size_t>( index )] = true;
+
+    return true;
+}
+
+int PresetBank::addUserPreset( const juce::String& name )
+{
+    Snapshot snapshot {};
+
+    for ( int index = 0; index < layout.size(); ++index ) {
+        snapshot[ static_cast<size_t>( index )] = layout.getUnchecked( index )->getValue();
+    }
+    const int index = add( name, snapshot, createPresetId());
+
+    if ( index >= 0 ) {
+        modified[ static_cast<size_t>( index )] = true;
+        publish();
+    }
+    return index;
+}
+
+bool PresetBank::loadUserPresets( const juce::File& file )
+{
+    std::vector<StoredPreset> stored;
+
+    if ( !readUserPresets( file, stored )) {
+        return false;
+    }
+
+    // replace the user presets
+
+    names.removeRange( numFactoryPresets, names.size());
+    bank.numPresets = numFactoryPresets;
+
+    for ( const auto& preset : stored ) {
+        if ( add( preset.name, preset.snapshot, preset.id ) < 0 ) {
+            break;
+        }
+    }
+    publish();
+
+    return true;
+}
+
+bool PresetBank::saveUserPresets( const juce::File& file )
+{
+    if ( !file.getParentDirectory().createDirectory()) {
+        return false;
+    }
+
+    // the file is read, merged and written by a single instance at a time (otherwise instances saving
+    // simultaneously would each write their own merge, where the last one drops the others' changes)
+
+    juce::InterProcessLock::ScopedLockType lock( fileLock );
+
+    if ( !lock.isLocked()) {
+        return false;
+    }
+
+    // the stored presets are written back, where those this bank added or renamed replace their stored version. The
+    // stored presets this bank doesn't hold or hasn't changed (e.g. renamed by another instance) are taken into the bank
+
+    std::vector<StoredPreset> stored;
+    bool merged = false;
+
+    if ( !readUserPresets( file, stored )) {
+        stored.clear();
+    }
+
+    for ( auto& preset : stored ) {
+        const int index = indexOf( preset.id );
+
+        if ( index < 0 ) {
+            merged |= add( preset.name, preset.snapshot, preset.id ) >= 0;
+        } else if ( modified[ static_cast<size_t>( index )]) {
+            preset.name     = names[ index ];
+            preset.snapshot = bank.presets[ static_cast<size_t>( index )];
+        } else if ( preset.name != names[ index ] || preset.snapshot != bank.presets[ static_cast<size_t>( index )]) {
+            names.set( index, preset.name );
+            bank.presets[ static_cast<size_t>( index )] = preset.snapshot;
+            merged = true;
+        }
+    }
+
+    // append the presets this bank added since it last saved
+
+    for ( int index = numFactoryPresets; index < names.size(); ++index ) {
+        const auto id = ids[ static_cast<size_t>( index )];
+        const bool isStored = std::any_of( stored.begin(), stored.end(), [ id ]( const StoredPreset& preset ) { return preset.id == id; });
+
+        if ( modified[ static_cast<size_t>( index )] && !isStored ) {
+            stored.push_back({ id, names[ index ], bank.presets[ static_cast<size_t>( index )] });
+        }
+    }
+
+    if ( merged ) {
+        publish();
+    }
+    juce::TemporaryFile temporaryFile( file );
+
+    {
+        juce::FileOutputStream stream( temporaryFile.getFile());
+
+        if ( !stream.openedOk()) {
+            return false;
+        }
+        stream.writeInt( FILE_ID );
+        stream.writeInt( FILE_VERSION );
+
+        // the IDs of the stored parameters, in the order of the values of each preset
+
+        stream.writeInt( layout.size());
+        for ( const auto* parameter : layout ) {
+            stream.writeString( parameter->getParameterID());
+        }
+
+        stream.writeInt( static_cast<int>( stored.size()));
+
+        for ( const auto& preset : stored ) {
+            stream.writeInt64( preset.id );
+            stream.writeString( preset.name );
+
+            for ( int index = 0; index < layout.size(); ++index ) {
+                stream.writeFloat( layout.getUnchecked( index )->convertFrom0to1( preset.snapshot[ static_cast<size_t>( index )]));
+            }
+        }
+        stream.flush();
+
+        if ( stream.getStatus().failed()) {
+            return false;
+        }
+    }
+    if ( !temporaryFile.overwriteTargetFileWithTemporary()) {
+        return false;
+    }
+    modified.fill( false );
+
+    return true;
+}
+
+juce::File PresetBank::getUserPresetFile()
+{
+    return juce::File::getSpecialLocation( juce::File::userApplicationDataDirectory )
+        .getChildFile( "igorski.nl" ).getChildFile( JucePlugin_Name ).getChildFile( "UserPresets.bin" );
+}
+
+void PresetBank::select( int index )
+{
+    if ( index < 0 || index >= numPublished.load( std::memory_order_acquire )) {
+        return;
+    }
+    selected.store( index, std::memory_order_relaxed );
+    unsynced.store( index, std::memory_order_relaxed );
+    pending.store( index, std::memory_order_release );
+
+    triggerAsyncUpdate();
+}
+
+void PresetBank::setSelected( int index )
+{
+    // a prior selection must not override the restored values
+
+    pending.store( -1, std::memory_order_release );
+    unsynced.store( -1, std::memory_order_relaxed );
+
+    if ( index >= 0 && index < numPublished.load( std::memory_order_acquire )) {
+        selected.store( index, std::memory_order_relaxed );
+    }
+}
+
+ParameterListener::Mask PresetBank::applyPendingSelection()
+{
+    if ( pending.load( std::memory_order_relaxed ) < 0 ) {
+        return 0;
+    }
+    const int index = pending.exchange( -1, std::memory_order_acquire );
+
+    // the selection is read before picking up the snapshots, so a preset that was added right before being
+    // selected is present (publish() takes place before the selection is stored)
+
+    published.update();
+
+    const auto& snapshots = published.getReadBuffer();
+
+    if ( index < 0 || index >= snapshots.numPresets ) {
+        return 0;
+    }
+    const auto& snapshot = snapshots.presets[ static_cast<size_t>( index )];
+
+    // only the values that differ are written and flagged, the others (e.g. those reconfiguring the FFT) remain
+    // untouched. The parameters are set to the same values on the message thread (see handleAsyncUpdate())
+
+    ParameterListener::Mask changed = 0;
+
+    for ( int parameterIndex = 0; parameterIndex < layout.size(); ++parameterIndex ) {
+        auto* rawValue    = rawValues[ static_cast<size_t>( parameterIndex )];
+        const float value = layout.getUnchecked( parameterIndex )->convertFrom0to1( snapshot[ static_cast<size_t>( parameterIndex )]);
+
+        if ( !juce::approximatelyEqual( rawValue->load( std::memory_order_relaxed ), value )) {
+            rawValue->store( value, std::memory_order_relaxed );
+            changed |= ParameterListener::Mask( 1 ) << parameterIndex;
+        }
+    }
+    return changed;
+}
+
+/* private methods */
+
+PresetBank::Snapshot PresetBank::createDefaultSnapshot() const
+{
+    Snapshot snapshot {};
+
+    for ( int index = 0; index < layout.size(); ++index ) {
+        snapshot[ static_cast<size_t>( index )] = layout.getUnchecked( index )->getDefaultValue();
+    }
+    return snapshot;
+}
+
+int PresetBank::add( const juce::String& name, const Snapshot& snapshot, juce::int64 id )
+{
+    const int index = names.size();
+
+    if ( index >= MAX_PRESETS ) {
+        return -1;
+    }
+    bank.presets[ static_cast<size_t>( index )] = snapshot;
+    ids[ static_cast<size_t>( index )] = id;
+    modified[ static_cast<size_t>( index )] = false;
+    bank.numPresets = index + 1;
+    names.add( name );
+
+    return index;
+}
+
+void PresetBank::publish()
+{
+    published.getWriteBuffer() = bank;
+    published.publish();
+
+    numPublished.store( bank.numPresets, std::memory_order_release );
+}
+
+void PresetBank::handleAsyncUpdate()
+{
+    const int index = unsynced.exchange( -1, std::memory_order_relaxed );
+
+    if ( index < 0 || index >= bank.numPresets ) {
+        return;
+    }
+    const auto& snapshot = bank.presets[ static_cast<size_t>( index )];
+
+    // each change is a gesture of its own, so hosts recording automation register it as a single step
+
+    for ( int parameterIndex = 0; parameterIndex < layout.size(); ++parameterIndex ) {
+        auto* parameter   = layout.getUnchecked( parameterIndex );
+        const float value = snapshot[ static_cast<size_t>( parameterIndex )];
+
+        if ( !juce::approximatelyEqual( parameter->getValue(), value )) {
+            parameter->beginChangeGesture();
+            parameter->setValueNotifyingHost( value );
+            parameter->endChangeGesture();
+        }
+    }
+}
+
+bool PresetBank::readUserPresets( const juce::File& file, std::vector<StoredPreset>& presets ) const
+{
+    juce::FileInputStream stream( file );
+
+    if ( !stream.openedOk() || stream.readInt() != FILE_ID || stream.readInt() != FILE_VERSION ) {
+        return false;
+    }
+
+    // map the stored parameters onto the parameter layout (-1 for parameters that no longer exist)
+
+    const int numStoredParameters = stream.readInt();
+
+    if ( numStoredParameters < 0 || numStoredParameters > MAX_PARAMETERS * 4 ) {
+        return false;
+    }
+    std::vector<int> indices;
+
+    for ( int column = 0; column < numStoredParameters; ++column ) {
+        auto* parameter = valueTreeState.getParameter( stream.readString());
+        indices.push_back( parameter != nullptr ? parameter->getParameterIndex() : -1 );
+    }
+
+    const int numPresets = stream.readInt();
+
+    for ( int preset = 0; preset < numPresets && preset < MAX_PRESETS; ++preset ) {
+        const auto id   = stream.readInt64();
+        const auto name = stream.readString();
+
+        if ( stream.getNumBytesRemaining() < static_cast<juce::int64>( numStoredParameters ) * static_cast<juce::int64>( sizeof( float ))) {
+            break; // truncated file
+        }
+        auto snapshot = createDefaultSnapshot();
+
+        for ( const int index : indices ) {
+            const float value = stream.readFloat();
+
+            if ( index >= 0 ) {
+                snapshot[ static_cast<size_t>( index )] = layout.getUnchecked( index )->convertTo0to1( value );
+            }
+        }
+        presets.push_back({ id, name, snapshot });
+    }
+    return true;
+}
+
+int PresetBank::indexOf( juce::int64 id ) const
+{
+    for ( int index = numFactoryPresets; index < names.size(); ++index ) {
+        if ( ids[ static_cast<size_t>( index )] == id ) {
+            return index;
+        }
+    }
+    return -1;
+}
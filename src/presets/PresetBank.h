@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../utils/TripleBuffer.h"
+#include "../ParameterListener.h"
+
+/**
+ * The programs of the plugin : the factory presets (see FactoryPresets.h) followed by the presets saved by the user.
+ *
+ * Presets are parsed into flat snapshots of the normalised values of all parameters (in order of the parameter layout)
+ * when loaded, so selecting a program on the audio thread requires neither allocations nor lookups by parameter ID.
+ * The snapshots are published to the audio thread as a whole (through a TripleBuffer), where a pending selection is
+ * written into the raw parameter values (those read by the processor) at the start of a block. All values of a program
+ * thus arrive in the same block, where the smoothed parameters ramp towards their new values. The parameters themselves
+ * are set on the message thread afterwards, as notifying the host and the editor is not realtime safe.
+ *
+ * User presets are stored in a compact binary file. Its header holds the IDs of the stored parameters, which are
+ * mapped onto the parameter layout once when loading (parameters not present in the file are at their default),
+ * followed by the identifiers, names and unnormalised values of the presets. As the file is shared by all instances
+ * of the plugin, saving re-reads the file (under an inter-process lock) and only writes back the presets this bank
+ * has added or renamed, the identifiers are used to merge the presets other instances have stored in the meantime.
+ */
+class PresetBank : private juce::AsyncUpdater
+{
+    public:
+        static constexpr int MAX_PRESETS    = 128;
+        static constexpr int MAX_PARAMETERS = ParameterListener::MAX_PARAMETERS;
+
+        explicit PresetBank( juce::AudioProcessorValueTreeState& parameters );
+        ~PresetBank() override;
+
+        /* message thread */
+
+        int getNumPresets() const { return names.size(); }
+        int getNumFactoryPresets() const { return numFactoryPresets; }
+
+        juce::String getName( int index ) const { return names[ index ]; }
+
+        // renames a user preset (factory presets can't be renamed), returns whether the name changed
+        bool setName( int index, const juce::String& name );
+
+        // stores the current parameter values as a new user preset, returns its index (or -1 when the bank is full)
+        int addUserPreset( const juce::String& name );
+
+        // replaces the user presets with those stored in provided file (see saveUserPresets()), returns whether it was read
+        bool loadUserPresets( const juce::File& file );
+
+        // stores the user presets this bank has added or renamed in provided file. The presets other instances stored in
+        // it since (e.g. those this bank doesn't hold or hasn't changed) are merged into the bank, returns whether it was written
+        bool saveUserPresets( const juce::File& file );
+
+        // the file the user presets are stored in by default
+        static juce::File getUserPresetFile();
+
+        /* any thread (e.g. the host selecting a program) */
+
+        // selects the program at provided index, applied on the next applyPendingSelection() call (out of range indices are ignored)
+        void select( int index );
+
+        // marks the program at provided index as selected without applying it (e.g. when restoring
+        // a state that already holds its values), out of range indices are ignored
+        void setSelected( int index );
+
+        int getSelected() const { return selected.load( std::memory_order_relaxed ); }
+
+        /* audio thread (or the thread preparing the processor) */
+
+        // applies the values of a pending selection onto the raw parameter values, returns the flags of the parameters
+        // that changed (to be handled alongside those collected by the ParameterListener)
+        ParameterListener::Mask applyPendingSelection();
+
+    private:
+        using Snapshot = std::array<float, MAX_PARAMETERS>;
+
+        struct Snapshots
+        {
+            std::array<Snapshot, MAX_PRESETS> presets;
+            int numPresets = 0;
+        };
+
+        juce::AudioProcessorValueTreeState& valueTreeState;
+
+        // the parameters in order of the parameter layout, along with their raw (unnormalised) values
+        juce::Array<juce::RangedAudioParameter*> layout;
+        std::array<std::atomic<float>*, MAX_PARAMETERS> rawValues {};
+
+        // the presets as kept by the message thread and the copy published to the audio thread
+
+        Snapshots bank;
+        juce::StringArray names;
+        std::array<juce::int64, MAX_PRESETS> ids {}; // identifies the user presets across instances (0 for the factory presets)
+        std::array<bool, MAX_PRESETS> modified {};  // whether a user preset was added or renamed since it was last saved
+        int numFactoryPresets = 0;
+        TripleBuffer<Snapshots> published;
+
+        std::atomic<int> numPublished { 0 }; // the amount of presets available to the audio thread
+        std::atomic<int> selected { 0 };
+        std::atomic<int> pending { -1 };
+        std::atomic<int> unsynced { -1 }; // the selected program the parameters are yet to be set to (see handleAsyncUpdate())
+
+        // a snapshot with all parameters at their default value
+        Snapshot createDefaultSnapshot() const;
+
+        // stores the snapshot under provided name and identifier, returns its index (or -1 when the bank is full)
+        int add( const juce::String& name, const Snapshot& snapshot, juce::int64 id );
+
+        struct StoredPreset
+        {
+            juce::int64 id;
+            juce::String name;
+            Snapshot snapshot;
+        };
+
+        // reads the user presets stored in provided file, returns whether it was read
+        bool readUserPresets( const juce::File& file, std::vector<StoredPreset>& presets ) const;
+
+        // the index of the user preset with provided identifier, -1 when the bank doesn't hold it
+        int indexOf( juce::int64 id ) const;
+
+        // serializes the saving of the instances sharing the user preset file
+        juce::InterProcessLock fileLock { juce::String( "igorski.nl_" ) + JucePlugin_Name + "_UserPresets" };
+
+        // provides the audio thread with the current contents of the bank
+        void publish();
+
+        // sets the parameters to the values of the selected program (on the message thread)
+        void handleAsyncUpdate() override;
+
+        JUCE_DECLARE_NON_COPYABLE( PresetBank )
+};
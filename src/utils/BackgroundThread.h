@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2024 Igor Zinken https://www.igorski.nl
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -16,8 +16,16 @@
  */
 #pragma once
 
-class ParameterSubscriber
+#include <juce_core/juce_core.h>
+
+/**
+ * A single low priority thread shared by all modules (obtained through juce::SharedResourcePointer) onto which
+ * work that should not take place on the audio thread is deferred, e.g. rebuilding lookup tables and masks.
+ * Modules register themselves as juce::TimeSliceClient.
+ */
+class BackgroundThread : public juce::TimeSliceThread
 {
     public:
-        virtual void updateParameters() = 0;
+        BackgroundThread() : juce::TimeSliceThread( "Phlegetron background worker" ) { startThread( juce::Thread::Priority::low ); }
+        ~BackgroundThread() override { stopThread( 1000 ); }
 };
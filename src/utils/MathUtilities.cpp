@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <juce_core/juce_core.h>
+#include "MathUtilities.h"
+
+// The kernel loops are written as plain scalar loops around the branch-free approximations, which the
+// compiler vectorizes. The same loop is compiled once for the baseline instruction set of the build target
+// (SSE2 on x86_64, NEON on arm64) and, when building with GCC or Clang for x86, once more for AVX2 and
+// AVX-512 using target attributes. The widest set supported by the CPU is selected once at runtime.
+
+#if ( defined( __x86_64__ ) || defined( __i386__ )) && ( defined( __GNUC__ ) || defined( __clang__ ))
+    #define MATH_UTILITIES_X86_DISPATCH 1
+    #define KERNEL_INLINE      __attribute__(( always_inline )) inline
+    #define KERNEL_AVX2        __attribute__(( target( "avx2,fma" )))
+    #define KERNEL_AVX512      __attribute__(( target( "avx512f,avx2,fma" )))
+#else
+    #define MATH_UTILITIES_X86_DISPATCH 0
+    #define KERNEL_INLINE      inline
+#endif
+
+namespace
+{
+    /* kernel loop bodies */
+
+    KERNEL_INLINE void signedPowLoop( float* channelData, unsigned long bufferSize, float exponent )
+    {
+        for ( unsigned long i = 0; i < bufferSize; ++i ) {
+            channelData[ i ] = MathUtilities::fastSignedPow( channelData[ i ], exponent );
+        }
+    }
+
+    KERNEL_INLINE void tanhLoop( float* channelData, unsigned long bufferSize, float drive, float outputGain )
+    {
+        for ( unsigned long i = 0; i < bufferSize; ++i ) {
+            channelData[ i ] = MathUtilities::fastTanh( channelData[ i ] * drive ) * outputGain;
+        }
+    }
+
+    KERNEL_INLINE void triangleFoldLoop( float* channelData, unsigned long bufferSize, float inputGain, float threshold )
+    {
+        const float inverseRange = 1.f / ( 2.f * threshold );
+
+        for ( unsigned long i = 0; i < bufferSize; ++i ) {
+            channelData[ i ] = MathUtilities::triangleFold( channelData[ i ] * inputGain, threshold, inverseRange );
+        }
+    }
+
+    KERNEL_INLINE void quantizeAndWrapLoop( float* channelData, unsigned long bufferSize, float levels, float gain )
+    {
+        for ( unsigned long i = 0; i < bufferSize; ++i ) {
+            channelData[ i ] = MathUtilities::quantizeAndWrap( channelData[ i ], levels, gain );
+        }
+    }
+
+    /* instruction set specific variants */
+
+    struct Kernels
+    {
+        void ( *signedPow )( float*, unsigned long, float );
+        void ( *tanh )( float*, unsigned long, float, float );
+        void ( *triangleFold )( float*, unsigned long, float, float );
+        void ( *quantizeAndWrap )( float*, unsigned long, float, float );
+        const char* instructionSet;
+    };
+
+    void signedPowBase( float* d, unsigned long n, float e ) { signedPowLoop( d, n, e ); }
+    void tanhBase( float* d, unsigned long n, float g, float o ) { tanhLoop( d, n, g, o ); }
+    void triangleFoldBase( float* d, unsigned long n, float g, float t ) { triangleFoldLoop( d, n, g, t ); }
+    void quantizeAndWrapBase( float* d, unsigned long n, float l, float g ) { quantizeAndWrapLoop( d, n, l, g ); }
+
+#if MATH_UTILITIES_X86_DISPATCH
+    KERNEL_AVX2 void signedPowAVX2( float* d, unsigned long n, float e ) { signedPowLoop( d, n, e ); }
+    KERNEL_AVX2 void tanhAVX2( float* d, unsigned long n, float g, float o ) { tanhLoop( d, n, g, o ); }
+    KERNEL_AVX2 void triangleFoldAVX2( float* d, unsigned long n, float g, float t ) { triangleFoldLoop( d, n, g, t ); }
+    KERNEL_AVX2 void quantizeAndWrapAVX2( float* d, unsigned long n, float l, float g ) { quantizeAndWrapLoop( d, n, l, g ); }
+
+    KERNEL_AVX512 void signedPowAVX512( float* d, unsigned long n, float e ) { signedPowLoop( d, n, e ); }
+    KERNEL_AVX512 void tanhAVX512( float* d, unsigned long n, float g, float o ) { tanhLoop( d, n, g, o ); }
+    KERNEL_AVX512 void triangleFoldAVX512( float* d, unsigned long n, float g, float t ) { triangleFoldLoop( d, n, g, t ); }
+    KERNEL_AVX512 void quantizeAndWrapAVX512( float* d, unsigned long n, float l, float g ) { quantizeAndWrapLoop( d, n, l, g ); }
+#endif
+
+    Kernels resolveKernels()
+    {
+#if MATH_UTILITIES_X86_DISPATCH
+        if ( juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3()) {
+            return { signedPowAVX512, tanhAVX512, triangleFoldAVX512, quantizeAndWrapAVX512, "AVX-512" };
+        }
+        if ( juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3()) {
+            return { signedPowAVX2, tanhAVX2, triangleFoldAVX2, quantizeAndWrapAVX2, "AVX2" };
+        }
+#endif
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __SSE2__ )
+        return { signedPowBase, tanhBase, triangleFoldBase, quantizeAndWrapBase, "SSE2" };
+#elif defined( __aarch64__ ) || defined( _M_ARM64 ) || defined( __ARM_NEON )
+        return { signedPowBase, tanhBase, triangleFoldBase, quantizeAndWrapBase, "NEON" };
+#else
+        return { signedPowBase, tanhBase, triangleFoldBase, quantizeAndWrapBase, "generic" };
+#endif
+    }
+
+    const Kernels& getKernels()
+    {
+        static const Kernels kernels = resolveKernels(); // resolved once, thread safe
+        return kernels;
+    }
+}
+
+/* block kernels */
+
+void MathUtilities::applySignedPow( float* channelData, unsigned long bufferSize, float exponent )
+{
+    getKernels().signedPow( channelData, bufferSize, exponent );
+}
+
+void MathUtilities::applyTanh( float* channelData, unsigned long bufferSize, float drive, float outputGain )
+{
+    getKernels().tanh( channelData, bufferSize, drive, outputGain );
+}
+
+void MathUtilities::applyTriangleFold( float* channelData, unsigned long bufferSize, float inputGain, float threshold )
+{
+    getKernels().triangleFold( channelData, bufferSize, inputGain, threshold );
+}
+
+void MathUtilities::applyQuantizeAndWrap( float* channelData, unsigned long bufferSize, float levels, float gain )
+{
+    getKernels().quantizeAndWrap( channelData, bufferSize, levels, gain );
+}
+
+const char* MathUtilities::getInstructionSet()
+{
+    return getKernels().instructionSet;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020 Igor Zinken https://www.igorski.nl
+ * Copyright (c) 2024-2026 Igor Zinken https://www.igorski.nl
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -14,7 +14,12 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#pragma once
+
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 
 class MathUtilities
 {
@@ -32,4 +37,146 @@ class MathUtilities
         static inline float clamp( float value ) {
             return juce::jlimit( -1.0f, 1.0f, value );
         }
+
+        /* fast math approximations */
+
+        // The functions below replace their <cmath> counterparts in the hot processing loops. They
+        // are branch-free and call no library functions, which allows the compiler to vectorize the
+        // loops they are used in (see the block kernels below). Error bounds are stated per function.
+
+        /**
+         * rounds towards negative infinity, valid for |value| < 2^31
+         */
+        static inline float fastFloor( float value ) {
+            const float truncated = static_cast<float>( static_cast<int32_t>( value ));
+            return truncated - ( value < truncated ? 1.f : 0.f );
+        }
+
+        /**
+         * 2 ^ value, input is clamped to the [-126, 126] range (e.g. no denormals or infinity)
+         * maximum relative error : 3e-7
+         */
+        static inline float fastExp2( float value ) {
+            value = std::min( 126.f, std::max( -126.f, value ));
+
+            // split into an integer part (stored in the exponent bits) and a fraction in the
+            // [-0.5, 0.5] range, for which 2 ^ fraction is approximated by its 6th order Taylor series
+
+            const float whole    = fastFloor( value + 0.5f );
+            const float fraction = value - whole;
+
+            const float poly = 1.f + fraction * ( 6.931471806e-1f + fraction * ( 2.402265070e-1f + fraction * ( 5.550410866e-2f +
+                               fraction * ( 9.618129108e-3f + fraction * ( 1.333355815e-3f + fraction * 1.540353039e-4f )))));
+
+            const int32_t exponentBits = ( static_cast<int32_t>( whole ) + 127 ) << 23;
+            float scale;
+            std::memcpy( &scale, &exponentBits, sizeof( float ));
+
+            return poly * scale;
+        }
+
+        /**
+         * log2( value ) for positive, normal values (zero and denormals return -126)
+         * maximum absolute error : 4e-7 (1 ulp of the result for | result | > 4)
+         */
+        static inline float fastLog2( float value ) {
+            int32_t bits;
+            std::memcpy( &bits, &value, sizeof( float ));
+
+            // split into exponent and mantissa, where the mantissa is normalized to the
+            // [sqrt(0.5), sqrt(2)) range so the series below converges quickly
+
+            int32_t exponent = (( bits >> 23 ) & 0xff ) - 127;
+            int32_t mantissaBits = ( bits & 0x007fffff ) | 0x3f800000;
+
+            const int32_t isLarge = mantissaBits > 0x3fb504f3 ? 1 : 0; // mantissa > sqrt(2)
+            exponent     += isLarge;
+            mantissaBits -= isLarge << 23;
+
+            float mantissa;
+            std::memcpy( &mantissa, &mantissaBits, sizeof( float ));
+
+            // ln( m ) = 2 * atanh(( m - 1 ) / ( m + 1 )), for which the first five series terms are used
+
+            const float t  = ( mantissa - 1.f ) / ( mantissa + 1.f );
+            const float t2 = t * t;
+            const float ln = 2.f * t * ( 1.f + t2 * ( 0.333333333f + t2 * ( 0.2f + t2 * ( 0.142857143f + t2 * 0.111111111f ))));
+
+            const float result = static_cast<float>( exponent ) + ln * 1.442695041f;
+
+            return exponent < -126 ? -126.f : result;
+        }
+
+        /**
+         * base ^ exponent for base >= 0 (returns 0 for a base of 0)
+         * maximum relative error : 5e-6 for | exponent * log2( base ) | < 64
+         */
+        static inline float fastPow( float base, float exponent ) {
+            const float result = fastExp2( exponent * fastLog2( base ));
+            return base > 0.f ? result : 0.f;
+        }
+
+        /**
+         * sign( value ) * | value | ^ exponent, e.g. a pow() that is symmetrical around the origin
+         */
+        static inline float fastSignedPow( float value, float exponent ) {
+            const float magnitude = fastPow( std::abs( value ), exponent );
+            return value < 0.f ? -magnitude : magnitude;
+        }
+
+        /**
+         * tanh( value ) computed as ( e - 1 ) / ( e + 1 ) where e = exp( 2 * value )
+         * maximum absolute error : 2e-7
+         */
+        static inline float fastTanh( float value ) {
+            value = std::min( 9.f, std::max( -9.f, value )); // tanh( 9 ) equals 1 within float precision
+
+            const float e = fastExp2( value * 2.885390082f ); // 2 / ln( 2 )
+            return ( e - 1.f ) / ( e + 1.f );
+        }
+
+        /**
+         * Folds value back onto itself whenever it exceeds provided threshold, the result is a triangle
+         * wave of period 2 * threshold in the [-threshold, 0] range. Equals ( without using fmod() ) :
+         * abs( fmod( value + threshold, 2 * threshold ) (wrapped to positive range) - threshold ) - threshold
+         */
+        static inline float triangleFold( float value, float threshold, float inverseRange ) {
+            const float range   = 2.f * threshold;
+            const float shifted = value + threshold;
+            const float wrapped = shifted - range * fastFloor( shifted * inverseRange );
+
+            return std::abs( wrapped - threshold ) - threshold;
+        }
+
+        /**
+         * Quantizes value onto provided amount of levels (per unit), amplifies it by provided gain and
+         * wraps the result back into the [-1, 1] range. Equals ( without using floor() and fmod() ) :
+         * fmod( floor( value * levels ) / levels * gain + 1, 2 ) - 1, for | value * levels | < 2^31
+         */
+        static inline float quantizeAndWrap( float value, float levels, float gain ) {
+            const float crushed = fastFloor( value * levels ) / levels * gain + 1.f;
+            const float wrapped = crushed - 2.f * static_cast<float>( static_cast<int32_t>( crushed * 0.5f )); // truncating like fmod()
+
+            return wrapped - 1.f;
+        }
+
+        /* block kernels */
+
+        // These apply the approximations above onto a buffer in place. The kernels are compiled for multiple
+        // instruction sets and dispatch at runtime to the widest set supported by the CPU (see MathUtilities.cpp)
+
+        // channelData[ i ] = fastSignedPow( channelData[ i ], exponent )
+        static void applySignedPow( float* channelData, unsigned long bufferSize, float exponent );
+
+        // channelData[ i ] = fastTanh( channelData[ i ] * drive ) * outputGain
+        static void applyTanh( float* channelData, unsigned long bufferSize, float drive, float outputGain );
+
+        // channelData[ i ] = triangleFold( channelData[ i ] * inputGain, threshold )
+        static void applyTriangleFold( float* channelData, unsigned long bufferSize, float inputGain, float threshold );
+
+        // channelData[ i ] = quantizeAndWrap( channelData[ i ], levels, gain )
+        static void applyQuantizeAndWrap( float* channelData, unsigned long bufferSize, float levels, float gain );
+
+        // name of the instruction set the block kernels dispatch to (e.g. "AVX2")
+        static const char* getInstructionSet();
 };
@@ -26,7 +26,54 @@ class ParameterUtilities {
             return juce::StringArray { "EQ", "Harmonic" };
         }
 
+        // the first entry selects the size automatically (by sample rate), the remainder
+        // correspond to Parameters::FFT::MIN_ORDER up to Parameters::FFT::MAX_ORDER
+        static juce::StringArray getFFTSizeNames() {
+            return { "Auto", "512", "1024", "2048", "4096", "8192" };
+        }
+
+        static juce::StringArray getFFTOverlapNames() {
+            return { "2x", "4x" };
+        }
+
+        // the oversampling factor of the band distortion, where the index equals Oversampler::setOrder()
+        static juce::StringArray getOversamplingNames() {
+            return { "Off", "2x", "4x", "8x" };
+        }
+
+        static juce::StringArray getAntiAliasingNames() {
+            return { "Off", "ADAA 1st order", "ADAA 2nd order" };
+        }
+
         static juce::StringArray getDistortionTypeNames() {
             return { "Off", "Waveshaper", "Wavefolder", "Fuzz", "Bit crusher" };
         }
+
+        // the duration of a cycle, where the index equals ModulationMatrix::getBeatsPerCycle() (T = triplet)
+        static juce::StringArray getLFORateNames() {
+            return { "4 bars", "2 bars", "1 bar", "1/2", "1/4", "1/4 T", "1/8", "1/8 T", "1/16", "1/16 T", "1/32" };
+        }
+
+        // where the index equals ModulationMatrix::Shape
+        static juce::StringArray getLFOShapeNames() {
+            return { "Sine", "Triangle", "Ramp up", "Ramp down", "Square" };
+        }
+
+        // where the index equals ModulationMatrix::Source
+        static juce::StringArray getModulationSourceNames() {
+            return { "Off", "LFO 1", "LFO 2", "Envelope" };
+        }
+
+        // the split frequencies (all splits move together) followed by the drive and param of each band, where
+        // the index equals ModulationMatrix::Target (the bands are in order of Parameters::BANDS)
+        static juce::StringArray getModulationTargetNames() {
+            return {
+                "Split frequency",
+                "Low drive",   "Low param",
+                "Mid 1 drive", "Mid 1 param",
+                "Mid 2 drive", "Mid 2 param",
+                "Mid 3 drive", "Mid 3 param",
+                "Hi drive",    "Hi param"
+            };
+        }
 };
\ No newline at end of file
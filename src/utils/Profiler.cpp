@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Profiler.h"
+#include <cmath>
+
+/* public methods */
+
+void Profiler::record( const StageTicks& stageTicks, juce::int64 blockTicks, int numSamples, double sampleRate )
+{
+    if ( resetRequested.exchange( false, std::memory_order_relaxed )) {
+        for ( auto& histogram : stages ) {
+            histogram.clear();
+        }
+        deadline.clear();
+    }
+
+    // stages that did not run during the block (e.g. the FFT split while using the EQ split) are not recorded
+
+    for ( size_t stage = 0; stage < stages.size(); ++stage ) {
+        if ( stageTicks[ stage ] <= 0 ) {
+            continue;
+        }
+        const double micros = juce::Time::highResolutionTicksToSeconds( stageTicks[ stage ]) * 1000000.0;
+        const int octave    = micros < 1.0 ? 0 : static_cast<int>( std::floor( std::log2( micros ))) + 1;
+
+        stages[ stage ].add( static_cast<size_t>( juce::jlimit( 0, NUM_BINS - 1, octave )), micros );
+    }
+
+    if ( numSamples <= 0 || sampleRate <= 0.0 ) {
+        return;
+    }
+    const double percentage = juce::Time::highResolutionTicksToSeconds( blockTicks ) * sampleRate / numSamples * 100.0;
+    const int step = static_cast<int>( percentage / DEADLINE_STEP );
+
+    deadline.add( static_cast<size_t>( juce::jlimit( 0, NUM_BINS - 1, step )), percentage );
+}
+
+juce::uint32 Profiler::getOverruns() const
+{
+    juce::uint32 overruns = 0;
+
+    for ( size_t bin = 100 / DEADLINE_STEP; bin < deadline.bins.size(); ++bin ) {
+        overruns += deadline.bins[ bin ].load( std::memory_order_relaxed );
+    }
+    return overruns;
+}
+
+const char* Profiler::getStageName( Stage stage )
+{
+    switch ( stage ) {
+        case Crossover:  return "Crossover";
+        case FFTSplit:   return "FFT split";
+        case Distortion: return "Distortion";
+        case MakeUp:     return "Make-up gain";
+        case DCFilter:   return "DC filter";
+        case NumStages:  break;
+    }
+    return "";
+}
+
+/* private methods */
+
+void Profiler::Histogram::add( size_t bin, double value )
+{
+    // as there is a single writer, the values can be updated without read-modify-write operations
+
+    bins[ bin ].store( bins[ bin ].load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    sum.store( sum.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+    max.store( std::max( max.load( std::memory_order_relaxed ), value ), std::memory_order_relaxed );
+    count.store( count.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+}
+
+void Profiler::Histogram::clear()
+{
+    for ( auto& bin : bins ) {
+        bin.store( 0, std::memory_order_relaxed );
+    }
+    sum.store( 0.0, std::memory_order_relaxed );
+    max.store( 0.0, std::memory_order_relaxed );
+    count.store( 0, std::memory_order_release );
+}
+
+Profiler::Snapshot Profiler::Histogram::read() const
+{
+    Snapshot snapshot;
+
+    snapshot.count = count.load( std::memory_order_acquire );
+
+    for ( size_t bin = 0; bin < bins.size(); ++bin ) {
+        snapshot.bins[ bin ] = bins[ bin ].load( std::memory_order_relaxed );
+    }
+    snapshot.mean = snapshot.count > 0 ? sum.load( std::memory_order_relaxed ) / snapshot.count : 0.0;
+    snapshot.max  = max.load( std::memory_order_relaxed );
+
+    return snapshot;
+}
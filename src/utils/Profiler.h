@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Realtime profiler for the stages of the processor (e.g. to find which stage is responsible for a dropout).
+ *
+ * During a block, the time spent in each stage is accumulated into a StageTicks counter (one per lane, so
+ * channels processed on different threads don't share a counter). Once the block has completed, the audio thread
+ * records the total time of each stage into its histogram, along with the time spent on the whole block relative
+ * to its deadline (the duration of the block at the sample rate).
+ *
+ * The histograms are only written by the audio thread and can be read by any thread without locking (e.g. by
+ * the editor), though a snapshot read during a recording may mix the values of two consecutive blocks.
+ * The profiler is disabled by default, in which case each timed section costs a single branch.
+ */
+class Profiler
+{
+    public:
+        enum Stage {
+            Crossover = 0, // including the recombination of the bands
+            FFTSplit,
+            Distortion, // including the oversampling of the bands
+            MakeUp,
+            DCFilter,
+            NumStages
+        };
+
+        // the stage histograms bin the time per block in octaves of microseconds : bin 0 holds times below 1 µs,
+        // bin n the times in the 2 ^ ( n - 1 ) to 2 ^ n µs range and the last bin all longer times. The deadline
+        // histogram bins the block time in steps of DEADLINE_STEP percent of the deadline (the last bin holding all longer times)
+
+        static constexpr int NUM_BINS = 16;
+        static constexpr int DEADLINE_STEP = 10;
+
+        struct Snapshot
+        {
+            std::array<juce::uint32, NUM_BINS> bins {};
+            juce::uint32 count = 0; // the amount of recorded blocks
+            double mean = 0.0; // in microseconds (stages) or percent of the deadline (blocks)
+            double max  = 0.0;
+        };
+
+        using StageTicks = std::array<juce::int64, NumStages>; // in juce::Time::getHighResolutionTicks() units
+
+        /**
+         * Adds the time spent within its scope to provided stage of the counter. When the counter
+         * is nullptr (e.g. when the profiler is disabled) no time is measured.
+         */
+        class ScopedTimer
+        {
+            public:
+                ScopedTimer( StageTicks* stageTicks, Stage timedStage )
+                    : ticks( stageTicks ), stage( timedStage ), startTicks( stageTicks != nullptr ? juce::Time::getHighResolutionTicks() : 0 ) {}
+
+                ~ScopedTimer() {
+                    if ( ticks != nullptr ) {
+                        ( *ticks )[ static_cast<size_t>( stage )] += juce::Time::getHighResolutionTicks() - startTicks;
+                    }
+                }
+
+            private:
+                StageTicks* ticks;
+                Stage stage;
+                juce::int64 startTicks;
+
+                JUCE_DECLARE_NON_COPYABLE( ScopedTimer )
+        };
+
+        void setEnabled( bool value ) { enabled.store( value, std::memory_order_relaxed ); }
+        bool isEnabled() const { return enabled.load( std::memory_order_relaxed ); }
+
+        // clears all histograms (can be invoked from any thread, takes effect when the next block is recorded)
+        void reset() { resetRequested.store( true, std::memory_order_relaxed ); }
+
+        // to be invoked by the audio thread once per block (while enabled)
+        void record( const StageTicks& stageTicks, juce::int64 blockTicks, int numSamples, double sampleRate );
+
+        Snapshot getStage( Stage stage ) const { return stages[ static_cast<size_t>( stage )].read(); }
+        Snapshot getDeadline() const { return deadline.read(); }
+
+        // the amount of recorded blocks that took longer than their deadline
+        juce::uint32 getOverruns() const;
+
+        static const char* getStageName( Stage stage );
+
+    private:
+        struct Histogram
+        {
+            std::array<std::atomic<juce::uint32>, NUM_BINS> bins {};
+            std::atomic<juce::uint32> count { 0 };
+            std::atomic<double> sum { 0.0 };
+            std::atomic<double> max { 0.0 };
+
+            void add( size_t bin, double value ); // single writer
+            void clear();
+            Snapshot read() const;
+        };
+
+        std::array<Histogram, NumStages> stages;
+        Histogram deadline;
+
+        std::atomic<bool> enabled { false };
+        std::atomic<bool> resetRequested { false };
+};
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * A small, fast and seedable pseudo random number generator to be owned by
+ * a single module instance (e.g. it is not shared between threads).
+ *
+ * Each value is the PCG "RXS M XS" output permutation of a 32-bit counter that advances
+ * by a fixed odd increment (a Weyl sequence). As values only depend on the counter, a block
+ * of values has no dependency chain between samples and the fill loops below vectorize.
+ * Equal seeds produce equal sequences, regardless of the block sizes used to consume them.
+ */
+class RandomGenerator
+{
+    public:
+        explicit RandomGenerator( uint32_t seed = 0 ) { setSeed( seed ); }
+
+        // restarts the sequence for provided seed
+        void setSeed( uint32_t seed ) {
+            _counter = permute( seed ^ 0x9e3779b9u );
+        }
+
+        inline uint32_t next() {
+            _counter += INCREMENT;
+            return permute( _counter );
+        }
+
+        // fills provided buffer with values within the [ 0, 1 ) range
+        void fillUnipolar( float* buffer, unsigned long bufferSize ) {
+            const uint32_t counter = _counter;
+
+            for ( unsigned long i = 0; i < bufferSize; ++i ) {
+                buffer[ i ] = toUnipolar( permute( counter + INCREMENT * static_cast<uint32_t>( i + 1 )));
+            }
+            _counter = counter + INCREMENT * static_cast<uint32_t>( bufferSize );
+        }
+
+        // fills provided buffer with values within the [ -1, 1 ) range
+        void fillBipolar( float* buffer, unsigned long bufferSize ) {
+            fillUnipolar( buffer, bufferSize );
+
+            for ( unsigned long i = 0; i < bufferSize; ++i ) {
+                buffer[ i ] = buffer[ i ] * 2.0f - 1.0f;
+            }
+        }
+
+    private:
+        static constexpr uint32_t INCREMENT = 0x6d2b79f5u;
+
+        uint32_t _counter = 0;
+
+        static inline uint32_t permute( uint32_t state ) {
+            const uint32_t word = (( state >> (( state >> 28u ) + 4u )) ^ state ) * 277803737u;
+            return ( word >> 22u ) ^ word;
+        }
+
+        // uses the upper 24 bits (the amount of bits a float mantissa can represent exactly)
+        static inline float toUnipolar( uint32_t value ) {
+            return static_cast<float>( value >> 8 ) * ( 1.0f / 16777216.0f );
+        }
+};
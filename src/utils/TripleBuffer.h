@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/**
+ * Wait-free exchange of a value between a single producer and a single consumer thread
+ * (e.g. a background thread rendering data and the audio thread reading it).
+ *
+ * The producer writes into its own buffer and publishes it, the consumer picks up the most
+ * recently published buffer. Neither side ever blocks, nor reads a buffer that is being written.
+ * All storage is owned by the instance, so no allocations take place during the exchange.
+ */
+template <typename T>
+class TripleBuffer
+{
+    static constexpr int INDEX_MASK = 3;
+    static constexpr int FRESH_FLAG = 4; // set when the middle buffer holds data not yet seen by the consumer
+
+    public:
+        /* producer */
+
+        // the buffer to write into, owned by the producer until publish() is called
+        T& getWriteBuffer() { return buffers[ static_cast<size_t>( backIndex )]; }
+
+        // makes the write buffer available to the consumer
+        void publish()
+        {
+            const int previous = middle.exchange( backIndex | FRESH_FLAG, std::memory_order_acq_rel );
+            backIndex = previous & INDEX_MASK;
+        }
+
+        /* consumer */
+
+        // picks up the most recently published buffer (if any), returns true when it changed
+        bool update()
+        {
+            if (( middle.load( std::memory_order_relaxed ) & FRESH_FLAG ) == 0 ) {
+                return false;
+            }
+            const int previous = middle.exchange( frontIndex, std::memory_order_acq_rel );
+            frontIndex = previous & INDEX_MASK;
+
+            return true;
+        }
+
+        // the buffer to read from, owned by the consumer until the next update() call
+        const T& getReadBuffer() const { return buffers[ static_cast<size_t>( frontIndex )]; }
+
+        /* setup (not thread safe, use only when neither side is running) */
+
+        template <typename Function>
+        void forEachBuffer( Function&& function )
+        {
+            for ( auto& buffer : buffers ) {
+                function( buffer );
+            }
+        }
+
+    private:
+        std::array<T, 3> buffers {};
+
+        int backIndex  = 0;
+        std::atomic<int> middle { 1 };
+        int frontIndex = 2;
+};
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "WorkerPool.h"
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+    #include <immintrin.h>
+#endif
+
+/* constructor / destructor */
+
+WorkerPool::WorkerPool( int numWorkers )
+{
+    for ( int i = 0; i < numWorkers; ++i ) {
+        auto worker = std::make_unique<Worker>( *this, i + 1 );
+        worker->startRealtimeThread( juce::Thread::RealtimeOptions{} );
+
+        workers.push_back( std::move( worker ));
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    for ( auto& worker : workers ) {
+        worker->signalThreadShouldExit();
+        worker->wakeUp.signal();
+    }
+    for ( auto& worker : workers ) {
+        worker->stopThread( PARK_TIMEOUT_MS * 10 );
+    }
+}
+
+/* private methods */
+
+void WorkerPool::dispatch( int numJobs, Invoker jobInvoker, void* jobFunction )
+{
+    jassert( numJobs <= 0xffff );
+
+    if ( numJobs <= 0 ) {
+        return;
+    }
+    invoker  = jobInvoker;
+    function = jobFunction;
+    completedJobs.store( 0, std::memory_order_relaxed );
+
+    // publish the batch (under a new generation) and wake up the workers that have parked
+    // (a worker flags itself as parked before checking for a new batch one last time, so none is missed).
+    // The flag is cleared when signalling, so a worker that has yet to wake up is not signalled again
+
+    const juce::uint32 generation = getGeneration( batch.load( std::memory_order_relaxed )) + 1;
+    batch.store(( static_cast<juce::uint64>( generation ) << 32 ) | static_cast<juce::uint64>( numJobs ));
+
+    for ( auto& worker : workers ) {
+        if ( worker->parked.exchange( false )) {
+            worker->wakeUp.signal();
+        }
+    }
+
+    // participate and wait for the jobs that are still running on the workers
+
+    processJobs( generation, 0 );
+
+    while ( completedJobs.load( std::memory_order_acquire ) < numJobs ) {
+        pause();
+    }
+}
+
+void WorkerPool::processJobs( juce::uint32 generation, int lane )
+{
+    juce::uint64 state = batch.load( std::memory_order_acquire );
+
+    while ( getGeneration( state ) == generation && getNextJob( state ) < getNumJobs( state ))
+    {
+        // claim the next job, a job can only be claimed while its batch has not completed,
+        // so the invoker and function (published along with the batch) are still valid
+
+        if ( !batch.compare_exchange_weak( state, state + ( 1 << 16 ), std::memory_order_acq_rel, std::memory_order_acquire )) {
+            continue;
+        }
+        invoker( function, getNextJob( state ), lane );
+        completedJobs.fetch_add( 1, std::memory_order_release );
+
+        state = batch.load( std::memory_order_acquire );
+    }
+}
+
+void WorkerPool::pause()
+{
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+    _mm_pause();
+#elif defined( __aarch64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ))
+    __asm__ __volatile__( "yield" );
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/* worker */
+
+WorkerPool::Worker::Worker( WorkerPool& workerPool, int workerLane ) :
+    juce::Thread( "Phlegetron worker " + juce::String( workerLane )), pool( workerPool ), lane( workerLane )
+{
+    // nowt...
+}
+
+void WorkerPool::Worker::run()
+{
+    juce::ScopedNoDenormals noDenormals; // the audio thread disables denormals, so should the workers
+
+    juce::uint32 lastGeneration = getGeneration( pool.batch.load( std::memory_order_acquire ));
+
+    while ( !threadShouldExit())
+    {
+        // await a new batch, spinning at first (batches often follow each other closely) and parking after
+
+        int iterations = 0;
+        while ( getGeneration( pool.batch.load( std::memory_order_acquire )) == lastGeneration && ++iterations < SPIN_ITERATIONS ) {
+            pause();
+        }
+
+        if ( getGeneration( pool.batch.load()) == lastGeneration ) {
+            parked.store( true );
+
+            if ( getGeneration( pool.batch.load()) == lastGeneration ) {
+                wakeUp.wait( PARK_TIMEOUT_MS );
+            }
+            parked.store( false );
+            continue;
+        }
+        lastGeneration = getGeneration( pool.batch.load( std::memory_order_acquire ));
+        pool.processJobs( lastGeneration, lane );
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Igor Zinken https://www.igorski.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * A small pool of pre-spawned threads onto which the audio thread can distribute independent jobs
+ * (e.g. the processing of individual channels), returning once all jobs have completed.
+ *
+ * Jobs are handed off without locking : a batch is published as a single atomic word (holding the
+ * batch generation, the next unclaimed job and the amount of jobs) from which threads claim jobs one
+ * at a time. The calling thread claims jobs as well. Idle workers spin briefly awaiting a new batch
+ * before parking, parked workers are woken by the dispatching thread.
+ *
+ * Waking a parked worker signals its juce::WaitableEvent, which briefly locks a mutex on the dispatching
+ * (audio) thread. Only workers that flagged themselves as parked are signalled (once per park), so spinning
+ * workers never cost a signal. Workers do park in between host blocks (which are further apart than the spin),
+ * this cost is accepted as the mutex is only ever contended by the worker being woken.
+ */
+class WorkerPool
+{
+    public:
+        explicit WorkerPool( int numWorkers );
+        ~WorkerPool();
+
+        // the amount of lanes jobs can run on, e.g. the workers plus the calling thread
+        int getNumLanes() const { return static_cast<int>( workers.size()) + 1; }
+
+        /**
+         * Invokes function( int jobIndex, int lane ) for each job in the 0 - numJobs range. The lane identifies the
+         * thread the job runs on (0 being the calling thread), jobs running on the same lane never overlap. Blocks
+         * until all jobs have completed. Does not allocate, should only be invoked by a single thread at a time.
+         */
+        template <typename Function>
+        void run( int numJobs, Function& function )
+        {
+            dispatch( numJobs, &invoke<Function>, &function );
+        }
+
+    private:
+        static constexpr int SPIN_ITERATIONS = 4096; // amount of iterations an idle worker awaits a new batch before parking
+        static constexpr int PARK_TIMEOUT_MS = 100;  // interval at which parked workers check whether they should exit
+
+        using Invoker = void ( * )( void* function, int jobIndex, int lane );
+
+        template <typename Function>
+        static void invoke( void* function, int jobIndex, int lane ) {
+            ( *static_cast<Function*>( function ))( jobIndex, lane );
+        }
+
+        class Worker : public juce::Thread
+        {
+            public:
+                Worker( WorkerPool& pool, int lane );
+                void run() override;
+
+                std::atomic<bool> parked { false };
+                juce::WaitableEvent wakeUp;
+
+            private:
+                WorkerPool& pool;
+                int lane;
+        };
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        // the current batch, the invoker and function are written before the batch is published
+
+        Invoker invoker = nullptr;
+        void* function  = nullptr;
+        std::atomic<juce::uint64> batch { 0 }; // generation (upper 32 bits), next job (16 bits) and amount of jobs (lower 16 bits)
+        std::atomic<int> completedJobs { 0 };
+
+        void dispatch( int numJobs, Invoker jobInvoker, void* jobFunction );
+        void processJobs( juce::uint32 generation, int lane );
+
+        static inline juce::uint32 getGeneration( juce::uint64 state ) { return static_cast<juce::uint32>( state >> 32 ); }
+        static inline int getNextJob( juce::uint64 state ) { return static_cast<int>(( state >> 16 ) & 0xffff ); }
+        static inline int getNumJobs( juce::uint64 state ) { return static_cast<int>( state & 0xffff ); }
+
+        static void pause();
+};